@@ -7,6 +7,7 @@
 #include "GameFramework/Pawn.h"
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/PlayerState.h"
+#include "Math/RandomStream.h"
 #include "Net/DataBunch.h"
 #include "Net/NetworkProfiler.h"
 
@@ -30,49 +31,16 @@ DECLARE_CYCLE_STAT(TEXT("ReplicateActor"), STAT_SpatialActorChannelReplicateActo
 DECLARE_CYCLE_STAT(TEXT("UpdateSpatialPosition"), STAT_SpatialActorChannelUpdateSpatialPosition, STATGROUP_SpatialNet);
 DECLARE_CYCLE_STAT(TEXT("ReplicateSubobject"), STAT_SpatialActorChannelReplicateSubobject, STATGROUP_SpatialNet);
 
-namespace
-{
-// This is a bookkeeping function that is similar to the one in RepLayout.cpp, modified for our needs (e.g. no NaKs)
-// We can't use the one in RepLayout.cpp because it's private and it cannot account for our approach.
-// In this function, we poll for any changes in Unreal properties compared to the last time we replicated this actor.
-void UpdateChangelistHistory(TSharedPtr<FRepState>& RepState)
-{
-	check(RepState->HistoryEnd >= RepState->HistoryStart);
-
-	const int32 HistoryCount = RepState->HistoryEnd - RepState->HistoryStart;
-	check(HistoryCount < FRepState::MAX_CHANGE_HISTORY);
-
-	for (int32 i = RepState->HistoryStart; i < RepState->HistoryEnd; i++)
-	{
-		const int32 HistoryIndex = i % FRepState::MAX_CHANGE_HISTORY;
-
-		FRepChangedHistory & HistoryItem = RepState->ChangeHistory[HistoryIndex];
-
-		// All active history items should contain a change list
-		check(HistoryItem.Changed.Num() > 0);
-
-		HistoryItem.Changed.Empty();
-		HistoryItem.OutPacketIdRange = FPacketIdRange();
-		RepState->HistoryStart++;
-	}
-
-	// Remove any tiling in the history markers to keep them from wrapping over time
-	const int32 NewHistoryCount = RepState->HistoryEnd - RepState->HistoryStart;
-
-	check(NewHistoryCount <= FRepState::MAX_CHANGE_HISTORY);
-
-	RepState->HistoryStart = RepState->HistoryStart % FRepState::MAX_CHANGE_HISTORY;
-	RepState->HistoryEnd = RepState->HistoryStart + NewHistoryCount;
-}
-}
-
 USpatialActorChannel::USpatialActorChannel(const FObjectInitializer& ObjectInitializer /*= FObjectInitializer::Get()*/)
 	: Super(ObjectInitializer)
 	, EntityId(0)
+	, ActorClassIndex(INDEX_NONE)
 	, bFirstTick(true)
+	, bMulticastsCulled(false)
 	, NetDriver(nullptr)
 	, LastSpatialPosition(FVector::ZeroVector)
 	, bCreatingNewEntity(false)
+	, NextHandoverReplicationTime(0.f)
 {
 }
 
@@ -152,19 +120,21 @@ bool USpatialActorChannel::CleanUp(const bool bForDestroy)
 	return UActorChannel::CleanUp(bForDestroy);
 }
 
-int64 USpatialActorChannel::Close()
+void USpatialActorChannel::DetachActorForPooling()
 {
-	DeleteEntityIfAuthoritative();
-	return Super::Close();
+	if (Actor == nullptr)
+	{
+		return;
+	}
+
+	Connection->ActorChannels.Remove(Actor);
+	Actor = nullptr;
 }
 
-bool USpatialActorChannel::IsDynamicArrayHandle(UObject* Object, uint16 Handle)
+int64 USpatialActorChannel::Close()
 {
-	check(ObjectHasReplicator(Object));
-	FObjectReplicator& Replicator = FindOrCreateReplicator(Object).Get();
-	TSharedPtr<FRepLayout>& RepLayout = Replicator.RepLayout;
-	check(Handle - 1 < RepLayout->BaseHandleToCmdIndex.Num());
-	return RepLayout->Cmds[RepLayout->BaseHandleToCmdIndex[Handle - 1].CmdIndex].Type == ERepLayoutCmdType::DynamicArray;
+	DeleteEntityIfAuthoritative();
+	return Super::Close();
 }
 
 void USpatialActorChannel::UpdateShadowData()
@@ -189,37 +159,10 @@ FRepChangeState USpatialActorChannel::CreateInitialRepChangeState(TWeakObjectPtr
 
 	FObjectReplicator& Replicator = FindOrCreateReplicator(Object).Get();
 
-	TArray<uint16> InitialRepChanged;
-
-	int32 DynamicArrayDepth = 0;
-	const int32 CmdCount = Replicator.RepLayout->Cmds.Num();
-	for (uint16 CmdIdx = 0; CmdIdx < CmdCount; ++CmdIdx)
-	{
-		const auto& Cmd = Replicator.RepLayout->Cmds[CmdIdx];
-
-		InitialRepChanged.Add(Cmd.RelativeHandle);
-
-		if (Cmd.Type == ERepLayoutCmdType::DynamicArray)
-		{
-			DynamicArrayDepth++;
-
-			// For the first layer of each dynamic array encountered at the root level
-			// add the number of array properties to conform to Unreal's RepLayout design and 
-			// allow FRepHandleIterator to jump over arrays. Cmd.EndCmd is an index into 
-			// RepLayout->Cmds[] that points to the value after the termination NULL of this array.
-			if (DynamicArrayDepth == 1)
-			{
-				InitialRepChanged.Add((Cmd.EndCmd - CmdIdx) - 2);
-			}
-		}
-		else if (Cmd.Type == ERepLayoutCmdType::Return)
-		{
-			DynamicArrayDepth--;
-			checkf(DynamicArrayDepth >= 0 || CmdIdx == CmdCount - 1, TEXT("Encountered erroneous RepLayout"));
-		}
-	}
-
-	return { InitialRepChanged, *Replicator.RepLayout };
+	// The initial data holds every replicated property.
+	FRepChangeState InitialRepChanges(*Replicator.RepLayout);
+	InitialRepChanges.RepChanged.Init(true, InitialRepChanges.RepChanged.Num());
+	return InitialRepChanges;
 }
 
 FHandoverChangeState USpatialActorChannel::CreateInitialHandoverChangeState(const FClassInfo& ClassInfo)
@@ -235,7 +178,7 @@ FHandoverChangeState USpatialActorChannel::CreateInitialHandoverChangeState(cons
 
 int64 USpatialActorChannel::ReplicateActor()
 {
-	SCOPE_CYCLE_COUNTER(STAT_SpatialActorChannelReplicateActor);
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialActorChannelReplicateActor);
 
 	if (!IsReadyForReplication())
 	{
@@ -247,6 +190,8 @@ int64 USpatialActorChannel::ReplicateActor()
 	check(Connection);
 	check(Connection->PackageMap);
 
+	SPATIALNET_SCOPE_CLASS_CYCLE_COUNTER(Actor->GetClass(), /* bSent */ true);
+
 	const UWorld* const ActorWorld = Actor->GetWorld();
 
 	// Time how long it takes to replicate this particular actor
@@ -312,20 +257,17 @@ int64 USpatialActorChannel::ReplicateActor()
 	bool bWroteSomethingImportant = false;
 	ActorReplicator->ChangelistMgr->Update(Actor, Connection->Driver->ReplicationFrame, ActorReplicator->RepState->LastCompareIndex, RepFlags, bForceCompareProperties);
 
-	const int32 PossibleNewHistoryIndex = ActorReplicator->RepState->HistoryEnd % FRepState::MAX_CHANGE_HISTORY;
-	FRepChangedHistory& PossibleNewHistoryItem = ActorReplicator->RepState->ChangeHistory[PossibleNewHistoryIndex];
-	TArray<uint16>& RepChanged = PossibleNewHistoryItem.Changed;
+	FRepChangeState RepChangeState(*ActorReplicator->RepLayout);
 
 	// Gather all change lists that are new since we last looked, and merge them all together into a single CL
 	for (int32 i = ActorReplicator->RepState->LastChangelistIndex; i < ChangelistState->HistoryEnd; i++)
 	{
 		const int32 HistoryIndex = i % FRepChangelistState::MAX_CHANGE_HISTORY;
 		FRepChangedHistory& HistoryItem = ChangelistState->ChangeHistory[HistoryIndex];
-		TArray<uint16> Temp = RepChanged;
 
 		if (HistoryItem.Changed.Num() > 0)
 		{
-			ActorReplicator->RepLayout->MergeChangeList((uint8*)Actor, HistoryItem.Changed, Temp, RepChanged);
+			RepChangeState.MergeChangelist(HistoryItem.Changed);
 		}
 		else
 		{
@@ -335,17 +277,12 @@ int64 USpatialActorChannel::ReplicateActor()
 
 	ActorReplicator->RepState->LastCompareIndex = ChangelistState->CompareIndex;
 
-	const FClassInfo& Info = NetDriver->ClassInfoManager->GetOrCreateClassInfoByClass(Actor->GetClass());
-
-	FHandoverChangeState HandoverChangeState;
+	const FClassInfo& Info = GetActorClassInfo();
 
-	if (ActorHandoverShadowData != nullptr)
-	{
-		HandoverChangeState = GetHandoverChangeList(*ActorHandoverShadowData, Actor);
-	}
+	const bool bRepChanged = RepChangeState.HasChanges();
 
 	// If any properties have changed, send a component update.
-	if (bCreatingNewEntity || RepChanged.Num() > 0 || HandoverChangeState.Num() > 0)
+	if (bCreatingNewEntity || bRepChanged)
 	{
 		if (bCreatingNewEntity)
 		{
@@ -357,24 +294,24 @@ int64 USpatialActorChannel::ReplicateActor()
 		}
 		else
 		{
-			FRepChangeState RepChangeState = { RepChanged, GetObjectRepLayout(Actor) };
-			Sender->SendComponentUpdates(Actor, Info, this, &RepChangeState, &HandoverChangeState);
+			Sender->SendComponentUpdates(Actor, Info, this, &RepChangeState, nullptr);
 		}
 
 		bWroteSomethingImportant = true;
-		if (RepChanged.Num() > 0)
-		{
-			ActorReplicator->RepState->HistoryEnd++;
-		}
 	}
 
-	UpdateChangelistHistory(ActorReplicator->RepState);
-
 	ActorReplicator->RepState->LastChangelistIndex = ChangelistState->HistoryEnd;
 
 	if (bCreatingNewEntity)
 	{
+		// The initial handover state went out with the entity creation request, so only seed the shadow data here.
+		if (ActorHandoverShadowData != nullptr)
+		{
+			GetHandoverChangeList(*ActorHandoverShadowData, Actor);
+		}
+
 		bCreatingNewEntity = false;
+		NextHandoverReplicationTime = NetDriver->Time + NetDriver->HandoverReplicationInterval;
 	}
 	else
 	{
@@ -393,25 +330,9 @@ int64 USpatialActorChannel::ReplicateActor()
 			}
 		}
 
-		for (auto& SubobjectInfoPair : GetHandoverSubobjects())
+		if (ShouldReplicateHandover())
 		{
-			UObject* Subobject = SubobjectInfoPair.Key;
-			FClassInfo& SubobjectInfo = *SubobjectInfoPair.Value;
-
-			// Handover shadow data should already exist for this object. If it doesn't, it must have
-			// started replicating after SetChannelActor was called on the owning actor.
-			TSharedRef<TArray<uint8>>* SubobjectHandoverShadowData = HandoverShadowDataMap.Find(Subobject);
-			if (SubobjectHandoverShadowData == nullptr)
-			{
-				UE_LOG(LogSpatialActorChannel, Warning, TEXT("EntityId: %lld Actor: %s HandoverShadowData not found for Subobject %s"), EntityId, *Actor->GetName(), *Subobject->GetName());
-				continue;
-			}
-
-			FHandoverChangeState SubobjectHandoverChangeState = GetHandoverChangeList(SubobjectHandoverShadowData->Get(), Subobject);
-			if (SubobjectHandoverChangeState.Num() > 0)
-			{
-				Sender->SendComponentUpdates(Subobject, SubobjectInfo, this, nullptr, &SubobjectHandoverChangeState);
-			}
+			bWroteSomethingImportant |= ReplicateHandover();
 		}
 	}
 
@@ -429,28 +350,76 @@ int64 USpatialActorChannel::ReplicateActor()
 	return (bWroteSomethingImportant) ? 1 : 0;	// TODO: return number of bits written (UNR-664)
 }
 
+bool USpatialActorChannel::ShouldReplicateHandover() const
+{
+	return NetDriver->HandoverReplicationInterval <= 0.f || NetDriver->Time >= NextHandoverReplicationTime;
+}
+
+bool USpatialActorChannel::ReplicateHandover()
+{
+	if (Actor == nullptr || bCreatingNewEntity)
+	{
+		return false;
+	}
+
+	bool bSentHandover = false;
+
+	if (ActorHandoverShadowData != nullptr)
+	{
+		FHandoverChangeState HandoverChangeState = GetHandoverChangeList(*ActorHandoverShadowData, Actor);
+		if (HandoverChangeState.Num() > 0)
+		{
+			Sender->SendComponentUpdates(Actor, GetActorClassInfo(), this, nullptr, &HandoverChangeState);
+			bSentHandover = true;
+		}
+	}
+
+	for (auto& SubobjectInfoPair : GetHandoverSubobjects())
+	{
+		UObject* Subobject = SubobjectInfoPair.Key;
+		FClassInfo& SubobjectInfo = *SubobjectInfoPair.Value;
+
+		// Handover shadow data should already exist for this object. If it doesn't, it must have
+		// started replicating after SetChannelActor was called on the owning actor.
+		TSharedRef<TArray<uint8>>* SubobjectHandoverShadowData = HandoverShadowDataMap.Find(Subobject);
+		if (SubobjectHandoverShadowData == nullptr)
+		{
+			UE_LOG(LogSpatialActorChannel, Warning, TEXT("EntityId: %lld Actor: %s HandoverShadowData not found for Subobject %s"), EntityId, *Actor->GetName(), *Subobject->GetName());
+			continue;
+		}
+
+		FHandoverChangeState SubobjectHandoverChangeState = GetHandoverChangeList(SubobjectHandoverShadowData->Get(), Subobject);
+		if (SubobjectHandoverChangeState.Num() > 0)
+		{
+			Sender->SendComponentUpdates(Subobject, SubobjectInfo, this, nullptr, &SubobjectHandoverChangeState);
+			bSentHandover = true;
+		}
+	}
+
+	NextHandoverReplicationTime = NetDriver->Time + NetDriver->HandoverReplicationInterval;
+
+	return bSentHandover;
+}
+
 bool USpatialActorChannel::ReplicateSubobject(UObject* Object, const FClassInfo& Info, const FReplicationFlags& RepFlags)
 {
-	SCOPE_CYCLE_COUNTER(STAT_SpatialActorChannelReplicateSubobject);
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialActorChannelReplicateSubobject);
 
 	FObjectReplicator& Replicator = FindOrCreateReplicator(Object).Get();
 	FRepChangelistState* ChangelistState = Replicator.ChangelistMgr->GetRepChangelistState();
 	Replicator.ChangelistMgr->Update(Object, Replicator.Connection->Driver->ReplicationFrame, Replicator.RepState->LastCompareIndex, RepFlags, bForceCompareProperties);
 
-	const int32 PossibleNewHistoryIndex = Replicator.RepState->HistoryEnd % FRepState::MAX_CHANGE_HISTORY;
-	FRepChangedHistory& PossibleNewHistoryItem = Replicator.RepState->ChangeHistory[PossibleNewHistoryIndex];
-	TArray<uint16>& RepChanged = PossibleNewHistoryItem.Changed;
+	FRepChangeState RepChangeState(*Replicator.RepLayout);
 
 	// Gather all change lists that are new since we last looked, and merge them all together into a single CL
 	for (int32 i = Replicator.RepState->LastChangelistIndex; i < ChangelistState->HistoryEnd; i++)
 	{
 		const int32 HistoryIndex = i % FRepChangelistState::MAX_CHANGE_HISTORY;
 		FRepChangedHistory& HistoryItem = ChangelistState->ChangeHistory[HistoryIndex];
-		TArray<uint16> Temp = RepChanged;
 
 		if (HistoryItem.Changed.Num() > 0)
 		{
-			Replicator.RepLayout->MergeChangeList((uint8*)Object, HistoryItem.Changed, Temp, RepChanged);
+			RepChangeState.MergeChangelist(HistoryItem.Changed);
 		}
 		else
 		{
@@ -460,17 +429,15 @@ bool USpatialActorChannel::ReplicateSubobject(UObject* Object, const FClassInfo&
 
 	Replicator.RepState->LastCompareIndex = ChangelistState->CompareIndex;
 
-	if (RepChanged.Num() > 0)
+	const bool bRepChanged = RepChangeState.HasChanges();
+	if (bRepChanged)
 	{
-		FRepChangeState RepChangeState = { RepChanged, GetObjectRepLayout(Object) };
 		Sender->SendComponentUpdates(Object, Info, this, &RepChangeState, nullptr);
-		Replicator.RepState->HistoryEnd++;
 	}
 
-	UpdateChangelistHistory(Replicator.RepState);
 	Replicator.RepState->LastChangelistIndex = ChangelistState->HistoryEnd;
 
-	return RepChanged.Num() > 0;
+	return bRepChanged;
 }
 
 bool USpatialActorChannel::ReplicateSubobject(UObject* Obj, FOutBunch& Bunch, const FReplicationFlags& RepFlags)
@@ -489,7 +456,7 @@ bool USpatialActorChannel::ReplicateSubobject(UObject* Obj, FOutBunch& Bunch, co
 
 TMap<UObject*, FClassInfo*> USpatialActorChannel::GetHandoverSubobjects()
 {
-	const FClassInfo& Info = NetDriver->ClassInfoManager->GetOrCreateClassInfoByClass(Actor->GetClass());
+	const FClassInfo& Info = GetActorClassInfo();
 
 	TMap<UObject*, FClassInfo*> FoundSubobjects;
 
@@ -529,25 +496,13 @@ void USpatialActorChannel::InitializeHandoverShadowData(TArray<uint8>& ShadowDat
 {
 	const FClassInfo& ClassInfo = NetDriver->ClassInfoManager->GetOrCreateClassInfoByClass(Object->GetClass());
 
-	uint32 Size = 0;
+	// The layout of the shadow data is precomputed with the class info, see FHandoverShadowRun.
+	ShadowData.AddZeroed(ClassInfo.HandoverShadowSize);
 	for (const FHandoverPropertyInfo& PropertyInfo : ClassInfo.HandoverProperties)
 	{
 		if (PropertyInfo.ArrayIdx == 0) // For static arrays, the first element will handle the whole array
 		{
-			// Make sure we conform to Unreal's alignment requirements; this is matched below and in ReplicateActor()
-			Size = Align(Size, PropertyInfo.Property->GetMinAlignment());
-			Size += PropertyInfo.Property->GetSize();
-		}
-	}
-	ShadowData.AddZeroed(Size);
-	uint32 Offset = 0;
-	for (const FHandoverPropertyInfo& PropertyInfo : ClassInfo.HandoverProperties)
-	{
-		if (PropertyInfo.ArrayIdx == 0)
-		{
-			Offset = Align(Offset, PropertyInfo.Property->GetMinAlignment());
-			PropertyInfo.Property->InitializeValue(ShadowData.GetData() + Offset);
-			Offset += PropertyInfo.Property->GetSize();
+			PropertyInfo.Property->InitializeValue(ShadowData.GetData() + PropertyInfo.ShadowOffset);
 		}
 	}
 }
@@ -558,20 +513,38 @@ FHandoverChangeState USpatialActorChannel::GetHandoverChangeList(TArray<uint8>&
 
 	const FClassInfo& ClassInfo = NetDriver->ClassInfoManager->GetOrCreateClassInfoByClass(Object->GetClass());
 
-	uint32 ShadowDataOffset = 0;
-	for (const FHandoverPropertyInfo& PropertyInfo : ClassInfo.HandoverProperties)
+	for (const FHandoverShadowRun& Run : ClassInfo.HandoverShadowRuns)
 	{
-		ShadowDataOffset = Align(ShadowDataOffset, PropertyInfo.Property->GetMinAlignment());
+		const uint8* Data = (uint8*)Object + Run.Offset;
+		uint8* StoredData = ShadowData.GetData() + Run.ShadowOffset;
+
+		if (!Run.bIsPlainOldData)
+		{
+			const FHandoverPropertyInfo& PropertyInfo = ClassInfo.HandoverProperties[Run.FirstProperty];
+			// Compare and assign.
+			if (bCreatingNewEntity || !PropertyInfo.Property->Identical(StoredData, Data))
+			{
+				HandoverChanged.Add(PropertyInfo.Handle);
+				PropertyInfo.Property->CopySingleValue(StoredData, Data);
+			}
+			continue;
+		}
+
+		if (!bCreatingNewEntity && FMemory::Memcmp(StoredData, Data, Run.Size) == 0)
+		{
+			continue;
+		}
 
-		const uint8* Data = (uint8*)Object + PropertyInfo.Offset;
-		uint8* StoredData = ShadowData.GetData() + ShadowDataOffset;
-		// Compare and assign.
-		if (bCreatingNewEntity || !PropertyInfo.Property->Identical(StoredData, Data))
+		// Something in the run changed, find out which properties it was and copy the whole run.
+		for (int32 PropertyIndex = Run.FirstProperty; PropertyIndex < Run.FirstProperty + Run.NumProperties; PropertyIndex++)
 		{
-			HandoverChanged.Add(PropertyInfo.Handle);
-			PropertyInfo.Property->CopySingleValue(StoredData, Data);
+			const FHandoverPropertyInfo& PropertyInfo = ClassInfo.HandoverProperties[PropertyIndex];
+			if (bCreatingNewEntity || FMemory::Memcmp(ShadowData.GetData() + PropertyInfo.ShadowOffset, (uint8*)Object + PropertyInfo.Offset, PropertyInfo.Property->ElementSize) != 0)
+			{
+				HandoverChanged.Add(PropertyInfo.Handle);
+			}
 		}
-		ShadowDataOffset += PropertyInfo.Property->ElementSize;
+		FMemory::Memcpy(StoredData, Data, Run.Size);
 	}
 
 	return HandoverChanged;
@@ -581,6 +554,8 @@ void USpatialActorChannel::SetChannelActor(AActor* InActor)
 {
 	Super::SetChannelActor(InActor);
 
+	ActorClassIndex = NetDriver->ClassInfoManager->GetOrCreateClassInfoByClass(InActor->GetClass()).ClassIndex;
+
 	// Get the entity ID from the entity registry (or return 0 if it doesn't exist).
 	check(NetDriver->GetEntityRegistry());
 	EntityId = NetDriver->GetEntityRegistry()->GetEntityIdFromActor(InActor);
@@ -603,7 +578,7 @@ void USpatialActorChannel::SetChannelActor(AActor* InActor)
 	check(!HandoverShadowDataMap.Contains(InActor));
 
 	// Create the shadow map, and store a quick access pointer to it
-	const FClassInfo& Info = NetDriver->ClassInfoManager->GetOrCreateClassInfoByClass(InActor->GetClass());
+	const FClassInfo& Info = GetActorClassInfo();
 	if (Info.SchemaComponents[SCHEMA_Handover] != SpatialConstants::INVALID_COMPONENT_ID)
 	{
 		ActorHandoverShadowData = &HandoverShadowDataMap.Add(InActor, MakeShared<TArray<uint8>>()).Get();
@@ -626,24 +601,85 @@ FObjectReplicator& USpatialActorChannel::PreReceiveSpatialUpdate(UObject* Target
 
 	FObjectReplicator& Replicator = FindOrCreateReplicator(TargetObject).Get();
 	TargetObject->PreNetReceive();
-	Replicator.RepLayout->InitShadowData(Replicator.RepState->StaticBuffer, TargetObject->GetClass(), (uint8*)TargetObject);
+
+	if (!PendingRepNotifies.Contains(TargetObject))
+	{
+		Replicator.RepLayout->InitShadowData(Replicator.RepState->StaticBuffer, TargetObject->GetClass(), (uint8*)TargetObject);
+	}
 
 	return Replicator;
 }
 
-void USpatialActorChannel::PostReceiveSpatialUpdate(UObject* TargetObject, const TArray<UProperty*>& RepNotifies)
+void USpatialActorChannel::PostReceiveSpatialUpdate(UObject* TargetObject, const TBitArray<>& RepNotifies)
 {
 	FNetworkGUID ObjectNetGUID = Connection->Driver->GuidCache->GetOrAssignNetGUID(TargetObject);
 	check(!ObjectNetGUID.IsDefault() && ObjectNetGUID.IsValid())
 
-	FObjectReplicator& Replicator = FindOrCreateReplicator(TargetObject).Get();
 	TargetObject->PostNetReceive();
-	Replicator.RepNotifies = RepNotifies;
-	Replicator.CallRepNotifies(false);
 
-	if (!TargetObject->IsPendingKill())
+	TBitArray<>* ObjectRepNotifies = PendingRepNotifies.Find(TargetObject);
+	if (ObjectRepNotifies == nullptr)
+	{
+		if (!RepNotifies.Contains(true))
+		{
+			if (!TargetObject->IsPendingKill())
+			{
+				TargetObject->PostRepNotifies();
+			}
+			return;
+		}
+
+		if (PendingRepNotifies.Num() == 0)
+		{
+			Receiver->AddChannelWithPendingRepNotifies(this);
+		}
+
+		ObjectRepNotifies = &PendingRepNotifies.Add(TargetObject, TBitArray<>(false, RepNotifies.Num()));
+	}
+
+	for (TConstSetBitIterator<> It(RepNotifies); It; ++It)
 	{
-		TargetObject->PostRepNotifies();
+		(*ObjectRepNotifies)[It.GetIndex()] = true;
+	}
+}
+
+void USpatialActorChannel::FlushRepNotifies()
+{
+	// Calling RepNotifies can destroy objects and close this channel, so work on a copy of the pending set.
+	TMap<TWeakObjectPtr<UObject>, TBitArray<>> RepNotifiesToCall = MoveTemp(PendingRepNotifies);
+	PendingRepNotifies.Reset();
+
+	for (TPair<TWeakObjectPtr<UObject>, TBitArray<>>& Pair : RepNotifiesToCall)
+	{
+		UObject* TargetObject = Pair.Key.Get();
+		if (TargetObject == nullptr || TargetObject->IsPendingKill() || !ObjectHasReplicator(TargetObject))
+		{
+			continue;
+		}
+
+		FObjectReplicator& Replicator = FindOrCreateReplicator(TargetObject).Get();
+		const TArray<FRepParentCmd>& Parents = Replicator.RepLayout->Parents;
+
+		Replicator.RepNotifies.Reset();
+		for (TConstSetBitIterator<> It(Pair.Value); It; ++It)
+		{
+			// Each element of a static array has its own parent, but they share the property and its RepNotify.
+			UProperty* Property = Parents[It.GetIndex()].Property;
+			if (Property->ArrayDim > 1)
+			{
+				Replicator.RepNotifies.AddUnique(Property);
+			}
+			else
+			{
+				Replicator.RepNotifies.Add(Property);
+			}
+		}
+		Replicator.CallRepNotifies(false);
+
+		if (!TargetObject->IsPendingKill())
+		{
+			TargetObject->PostRepNotifies();
+		}
 	}
 }
 
@@ -728,7 +764,7 @@ void USpatialActorChannel::OnCreateEntityResponse(const Worker_CreateEntityRespo
 
 void USpatialActorChannel::UpdateSpatialPosition()
 {
-	SCOPE_CYCLE_COUNTER(STAT_SpatialActorChannelUpdateSpatialPosition);
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialActorChannelUpdateSpatialPosition);
 
 	// PlayerController's and PlayerState's are a special case here. To ensure that they and their associated pawn are 
 	// handed between workers at the same time (which is not guaranteed), we ensure that we update the position component 
@@ -798,30 +834,31 @@ FVector USpatialActorChannel::GetActorSpatialPosition(AActor* InActor)
 	return FRepMovement::RebaseOntoZeroOrigin(Location, InActor);
 }
 
-void USpatialActorChannel::RemoveRepNotifiesWithUnresolvedObjs(TArray<UProperty*>& RepNotifies, const FRepLayout& RepLayout, const FObjectReferencesMap& RefMap, UObject* Object)
+void USpatialActorChannel::RemoveRepNotifiesWithUnresolvedObjs(TBitArray<>& RepNotifies, const FRepLayout& RepLayout, const FObjectReferencesMap& RefMap, UObject* Object)
 {
 	// Prevent rep notify callbacks from being issued when unresolved obj references exist inside UStructs.
 	// This prevents undefined behaviour when engine rep callbacks are issued where they don't expect unresolved objects in native flow.
-	RepNotifies.RemoveAll([&](UProperty* Property)
+	for (auto& ObjRef : RefMap)
 	{
-		for (auto& ObjRef : RefMap)
+		const int32 ParentIndex = ObjRef.Value.ParentIndex;
+
+		// ParentIndex will be -1 for handover properties.
+		if (ParentIndex < 0 || !RepNotifies[ParentIndex])
 		{
-			// ParentIndex will be -1 for handover properties.
-			if (ObjRef.Value.ParentIndex < 0)
-			{
-				continue;
-			}
+			continue;
+		}
 
-			bool bIsSameRepNotify = RepLayout.Parents[ObjRef.Value.ParentIndex].Property == Property;
-			bool bIsArray = RepLayout.Parents[ObjRef.Value.ParentIndex].Property->ArrayDim > 1;
-			if (bIsSameRepNotify && !bIsArray)
-			{
-				UE_LOG(LogSpatialActorChannel, Verbose, TEXT("RepNotify %s on %s ignored due to unresolved Actor"), *Property->GetName(), *Object->GetName());
-				return true;
-			}
+		UProperty* Property = RepLayout.Parents[ParentIndex].Property;
+
+		// The RepNotify of a static array is shared by all its elements, so it isn't dropped for a single unresolved element.
+		if (Property->ArrayDim > 1)
+		{
+			continue;
 		}
-		return false;
-	});
+
+		UE_LOG(LogSpatialActorChannel, Verbose, TEXT("RepNotify %s on %s ignored due to unresolved Actor"), *Property->GetName(), *Object->GetName());
+		RepNotifies[ParentIndex] = false;
+	}
 }
 
 void USpatialActorChannel::SpatialViewTick()
@@ -860,3 +897,123 @@ void USpatialActorChannel::SpatialViewTick()
 		}
 	}
 }
+
+uint32 USpatialActorChannel::GetNextUnreliableRPCSequence(Worker_ComponentId ComponentId)
+{
+	uint32* Sequence = OutgoingUnreliableRPCSequences.Find(ComponentId);
+	if (Sequence == nullptr)
+	{
+		// Start at a random sequence, so a receiver which heard from the previous authoritative worker isn't likely to drop these.
+		// FMath::Rand only covers 15 bits, which would make a collision with the previous sequence window too likely.
+		static FRandomStream SequenceStream((int32)FPlatformTime::Cycles());
+		Sequence = &OutgoingUnreliableRPCSequences.Add(ComponentId, SequenceStream.GetUnsignedInt());
+	}
+
+	return (*Sequence)++;
+}
+
+bool USpatialActorChannel::OnReceivedUnreliableRPC(Worker_ComponentId ComponentId, uint32 Sequence)
+{
+	// Only a small step back is treated as a late RPC, anything further back means a different worker is sending them now.
+	const uint32* LastSequence = IncomingUnreliableRPCSequences.Find(ComponentId);
+	if (LastSequence != nullptr && *LastSequence - Sequence < SpatialConstants::UNRELIABLE_RPC_SEQUENCE_WINDOW)
+	{
+		return false;
+	}
+
+	IncomingUnreliableRPCSequences.Add(ComponentId, Sequence);
+	return true;
+}
+
+#if !UE_BUILD_SHIPPING
+uint32 USpatialActorChannel::GetNextReliableRPCId(ESchemaComponentType RPCType)
+{
+	FReliableRPCId& RPCIdEntry = ReliableRPCIds[RPCType - SCHEMA_FirstRPC];
+
+	if (!RPCIdEntry.WorkerId.IsNone())
+	{
+		// We previously used to receive RPCs of this type, now we're about to send one, so we reset the reliable RPC index.
+		// This should only be possible for CrossServer RPCs.
+		check(RPCType == SCHEMA_CrossServerRPC);
+		UE_LOG(LogSpatialActorChannel, Verbose, TEXT("Actor %s: Used to receive reliable CrossServer RPCs from worker %s, now about to send one. The entity must have crossed boundary."),
+			*Actor->GetName(), *RPCIdEntry.WorkerId.ToString());
+		RPCIdEntry = FReliableRPCId();
+	}
+
+	return ++RPCIdEntry.RPCId;
+}
+
+void USpatialActorChannel::OnReceivedReliableRPC(ESchemaComponentType RPCType, FName WorkerId, uint32 RPCId, UObject* TargetObject, UFunction* Function)
+{
+	check(!WorkerId.IsNone());
+
+	FReliableRPCId& RPCIdEntry = ReliableRPCIds[RPCType - SCHEMA_FirstRPC];
+	const uint32 RPCIndex = NetDriver->ClassInfoManager->GetOrCreateClassInfoByObject(TargetObject).RPCInfoMap.FindChecked(Function).Index;
+
+	auto GetLastRPCDescription = [this, RPCType, &RPCIdEntry]() -> FString
+	{
+		UObject* LastRPCTarget = RPCIdEntry.LastRPCTarget.Get();
+		if (LastRPCTarget == nullptr)
+		{
+			return FString::Printf(TEXT("index %u of a destroyed target"), RPCIdEntry.LastRPCIndex);
+		}
+
+		const TArray<UFunction*>& RPCArray = NetDriver->ClassInfoManager->GetOrCreateClassInfoByObject(LastRPCTarget).RPCs.FindChecked(RPCType);
+		return FString::Printf(TEXT("%s, target %s"), *RPCArray[RPCIdEntry.LastRPCIndex]->GetName(), *LastRPCTarget->GetName());
+	};
+
+	if (WorkerId != RPCIdEntry.WorkerId)
+	{
+		if (RPCIdEntry.RPCId != 0 && RPCIdEntry.WorkerId.IsNone())
+		{
+			// We previously used to send RPCs of this type, now we received one. This should only be possible for CrossServer RPCs.
+			check(RPCType == SCHEMA_CrossServerRPC);
+			UE_LOG(LogSpatialActorChannel, Verbose, TEXT("Actor %s, object %s: Used to send reliable CrossServer RPCs, now received one from worker %s. The entity must have crossed boundary."),
+				*Actor->GetName(), *TargetObject->GetName(), *WorkerId.ToString());
+		}
+		else if (!RPCIdEntry.WorkerId.IsNone())
+		{
+			// We received an RPC from a different worker than the one we used to receive RPCs of this type from.
+			UE_LOG(LogSpatialActorChannel, Verbose, TEXT("Actor %s, object %s: Received a reliable %s RPC from a different worker %s. Previously received from worker %s."),
+				*Actor->GetName(), *TargetObject->GetName(), *RPCSchemaTypeToString(RPCType), *WorkerId.ToString(), *RPCIdEntry.WorkerId.ToString());
+		}
+		RPCIdEntry.WorkerId = WorkerId;
+	}
+	else if (RPCId != RPCIdEntry.RPCId + 1)
+	{
+		if (RPCId < RPCIdEntry.RPCId)
+		{
+			UE_LOG(LogSpatialActorChannel, Verbose, TEXT("Actor %s: Reliable %s RPC received out of order! Previously received RPC: %s, index %u. Now received: %s, target %s, index %u. Sender: %s"),
+				*Actor->GetName(), *RPCSchemaTypeToString(RPCType), *GetLastRPCDescription(), RPCIdEntry.RPCId, *Function->GetName(), *TargetObject->GetName(), RPCId, *WorkerId.ToString());
+		}
+		else if (RPCId == RPCIdEntry.RPCId)
+		{
+			UE_LOG(LogSpatialActorChannel, Verbose, TEXT("Actor %s: Reliable %s RPC index duplicated! Previously received RPC: %s, index %u. Now received: %s, target %s, index %u. Sender: %s"),
+				*Actor->GetName(), *RPCSchemaTypeToString(RPCType), *GetLastRPCDescription(), RPCIdEntry.RPCId, *Function->GetName(), *TargetObject->GetName(), RPCId, *WorkerId.ToString());
+		}
+		else
+		{
+			UE_LOG(LogSpatialActorChannel, Verbose, TEXT("Actor %s: One or more reliable %s RPCs skipped! Previously received RPC: %s, index %u. Now received: %s, target %s, index %u. Sender: %s"),
+				*Actor->GetName(), *RPCSchemaTypeToString(RPCType), *GetLastRPCDescription(), RPCIdEntry.RPCId, *Function->GetName(), *TargetObject->GetName(), RPCId, *WorkerId.ToString());
+		}
+	}
+
+	RPCIdEntry.RPCId = RPCId;
+	RPCIdEntry.LastRPCTarget = TargetObject;
+	RPCIdEntry.LastRPCIndex = RPCIndex;
+}
+
+void USpatialActorChannel::OnRPCAuthorityGained(ESchemaComponentType RPCType)
+{
+	// When we gain authority on an RPC component of an actor that we previously received RPCs for, reset the reliable RPC counter.
+	// This is to account for the case where the actor crosses to another worker, receives a couple of reliable RPCs, and comes back
+	// to the original worker.
+	FReliableRPCId& RPCIdEntry = ReliableRPCIds[RPCType - SCHEMA_FirstRPC];
+	if (!RPCIdEntry.WorkerId.IsNone() || RPCIdEntry.RPCId != 0)
+	{
+		UE_LOG(LogSpatialActorChannel, Verbose, TEXT("Actor %s: Gained authority over %s RPC component. Resetting previous reliable RPC counter."),
+			*Actor->GetName(), *RPCSchemaTypeToString(RPCType));
+		RPCIdEntry = FReliableRPCId();
+	}
+}
+#endif // !UE_BUILD_SHIPPING
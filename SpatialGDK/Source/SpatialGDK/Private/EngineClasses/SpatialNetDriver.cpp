@@ -10,6 +10,7 @@
 #include "Engine/NetworkObjectList.h"
 #include "GameFramework/GameModeBase.h"
 #include "GameFramework/GameNetworkManager.h"
+#include "GameFramework/PlayerController.h"
 #include "Net/DataReplication.h"
 #include "Net/RepLayout.h"
 #include "SocketSubsystem.h"
@@ -19,6 +20,7 @@
 #include "Interop/GlobalStateManager.h"
 #include "Interop/SnapshotManager.h"
 #include "Interop/SpatialClassInfoManager.h"
+#include "Interop/SpatialMetrics.h"
 #include "Interop/SpatialPlayerSpawner.h"
 #include "Interop/SpatialReceiver.h"
 #include "Interop/SpatialSender.h"
@@ -29,11 +31,13 @@
 #include "EngineClasses/SpatialPackageMapClient.h"
 #include "EngineClasses/SpatialPendingNetGame.h"
 #include "SpatialConstants.h"
+#include "Utils/ActorPool.h"
 #include "Utils/EntityRegistry.h"
 
 DEFINE_LOG_CATEGORY(LogSpatialOSNetDriver);
 
 DECLARE_CYCLE_STAT(TEXT("ServerReplicateActors"), STAT_SpatialServerReplicateActors, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("UpdateMulticastRelevancy"), STAT_SpatialUpdateMulticastRelevancy, STATGROUP_SpatialNet);
 DEFINE_STAT(STAT_SpatialConsiderList);
 
 bool USpatialNetDriver::InitBase(bool bInitAsClient, FNetworkNotify* InNotify, const FURL& URL, bool bReuseAddressAndPort, FString& Error)
@@ -53,6 +57,7 @@ bool USpatialNetDriver::InitBase(bool bInitAsClient, FNetworkNotify* InNotify, c
 	ClassInfoManager->Init(this);
 
 	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &USpatialNetDriver::OnMapLoaded);
+	OnWorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddUObject(this, &USpatialNetDriver::OnWorldCleanup);
 
 	// Make absolutely sure that the actor channel that we are using is our Spatial actor channel
 	ChannelClasses[CHTYPE_Actor] = USpatialActorChannel::StaticClass();
@@ -123,6 +128,8 @@ void USpatialNetDriver::OnMapLoaded(UWorld* LoadedWorld)
 
 	// Set up manager objects.
 	EntityRegistry = NewObject<UEntityRegistry>(this);
+	ActorPool = NewObject<UActorPool>(this);
+	ActorPool->Init(this);
 
 	USpatialGameInstance* GameInstance = Cast<USpatialGameInstance>(GetWorld()->GetGameInstance());
 
@@ -185,6 +192,38 @@ void USpatialNetDriver::OnMapLoaded(UWorld* LoadedWorld)
 	Connect();
 }
 
+void USpatialNetDriver::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	if (World != GetWorld())
+	{
+		return;
+	}
+
+	// Pooled actors belong to the world being cleaned up, don't keep them for the next map.
+	if (ActorPool != nullptr)
+	{
+		ActorPool->Empty();
+	}
+}
+
+void USpatialNetDriver::Shutdown()
+{
+	FWorldDelegates::OnWorldCleanup.Remove(OnWorldCleanupHandle);
+
+	// Sends the multicasts of the last tick if still connected, and frees them otherwise.
+	if (Sender != nullptr)
+	{
+		Sender->FlushMulticastRPCs();
+	}
+
+	if (ActorPool != nullptr)
+	{
+		ActorPool->Empty();
+	}
+
+	Super::Shutdown();
+}
+
 void USpatialNetDriver::Connect()
 {
 	Connection->OnConnected.BindLambda([this]
@@ -246,6 +285,12 @@ void USpatialNetDriver::OnMapLoadedAndConnected()
 	GlobalStateManager->Init(this, TimerManager);
 	SnapshotManager->Init(this);
 
+	if (MetricsReportInterval > 0.f)
+	{
+		SpatialMetrics = NewObject<USpatialMetrics>();
+		SpatialMetrics->Init(this);
+	}
+
 	// Bind the ProcessServerTravel delegate to the spatial variant. This ensures that if ServerTravel is called and Spatial networking is enabled, we can travel properly.
 	GetWorld()->SpatialProcessServerTravelDelegate.BindStatic(SpatialProcessServerTravel);
 
@@ -863,7 +908,7 @@ int32 USpatialNetDriver::ServerReplicateActors_ProcessPrioritizedActors(UNetConn
 // For this reason, things like ready checks, acks, throttling based on number of updated connections, interest management are irrelevant at this level.
 int32 USpatialNetDriver::ServerReplicateActors(float DeltaSeconds)
 {
-	SCOPE_CYCLE_COUNTER(STAT_SpatialServerReplicateActors);
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialServerReplicateActors);
 
 #if WITH_SERVER_CODE
 	if (ClientConnections.Num() == 0)
@@ -1047,9 +1092,20 @@ void USpatialNetDriver::TickDispatch(float DeltaTime)
 	{
 		Worker_OpList* OpList = Connection->GetOpList();
 
+		LatencyTracer.OnOpListReceived();
+
+		const double ProcessOpsStartTime = FPlatformTime::Seconds();
+
 		Dispatcher->ProcessOps(OpList);
 
+		if (SpatialMetrics != nullptr)
+		{
+			SpatialMetrics->OnOpsProcessed(OpList->op_count, (FPlatformTime::Seconds() - ProcessOpsStartTime) * 1000.0);
+		}
+
 		Worker_OpList_Destroy(OpList);
+
+		Receiver->ProcessQueuedEntityCheckouts();
 	}
 }
 
@@ -1093,9 +1149,15 @@ void USpatialNetDriver::ProcessRemoteFunction(
 		TSharedRef<FPendingRPCParams> RPCParams = MakeShared<FPendingRPCParams>(CallingObject, Function, Parameters, NextRPCIndex++);
 
 #if !UE_BUILD_SHIPPING
-		if (Function->HasAnyFunctionFlags(FUNC_NetReliable) && !Function->HasAnyFunctionFlags(FUNC_NetMulticast))
+		// RPCs sent through a ring buffer can't arrive out of order, so they aren't numbered either.
+		if (Function->HasAnyFunctionFlags(FUNC_NetReliable) && !Function->HasAnyFunctionFlags(FUNC_NetMulticast)
+			&& !(bUseRPCRingBuffers && Function->HasAnyFunctionFlags(FUNC_NetClient | FUNC_NetServer)))
 		{
-			RPCParams->ReliableRPCIndex = GetNextReliableRPCId(Actor, FunctionFlagsToRPCSchemaType(Function->FunctionFlags), CallingObject);
+			// RPCs sent before the actor has a channel aren't numbered, and the receiver doesn't check the order of those.
+			if (USpatialActorChannel* Channel = GetActorChannelByEntityId(EntityRegistry->GetEntityIdFromActor(Actor)))
+			{
+				RPCParams->ReliableRPCIndex = Channel->GetNextReliableRPCId(FunctionFlagsToRPCSchemaType(Function->FunctionFlags));
+			}
 		}
 #endif // !UE_BUILD_SHIPPING
 
@@ -1120,8 +1182,18 @@ void USpatialNetDriver::TickFlush(float DeltaTime)
 		double ServerReplicateActorsTimeStart = FPlatformTime::Seconds();
 #endif // USE_SERVER_PERF_COUNTERS
 
+		const double ReplicateActorsStartTime = FPlatformTime::Seconds();
+
+		// Multicast RPCs called this tick go out before the property updates, as they did before being batched.
+		Sender->FlushMulticastRPCs();
+
 		int32 Updated = ServerReplicateActors(DeltaTime);
 
+		if (SpatialMetrics != nullptr)
+		{
+			SpatialMetrics->OnServerReplicateActors(Updated, (FPlatformTime::Seconds() - ReplicateActorsStartTime) * 1000.0);
+		}
+
 #if USE_SERVER_PERF_COUNTERS
 		ServerReplicateActorsTimeMs = (FPlatformTime::Seconds() - ServerReplicateActorsTimeStart) * 1000.0;
 #endif // USE_SERVER_PERF_COUNTERS
@@ -1136,9 +1208,96 @@ void USpatialNetDriver::TickFlush(float DeltaTime)
 #endif // WITH_SERVER_CODE
 	}
 
+	if (Sender != nullptr)
+	{
+		// Send the multicast RPCs which were called or resolved while replicating, or with no clients to replicate to.
+		// If the connection was lost they are dropped instead.
+		Sender->FlushMulticastRPCs();
+	}
+
+	if (Connection != nullptr && Connection->IsConnected())
+	{
+		if (!IsServer() && MulticastRelevancyUpdateInterval > 0.f && Time >= NextMulticastRelevancyUpdateTime)
+		{
+			NextMulticastRelevancyUpdateTime = Time + MulticastRelevancyUpdateInterval;
+			UpdateMulticastRelevancy();
+		}
+	}
+
+	if (SpatialMetrics != nullptr)
+	{
+		SpatialMetrics->TickMetrics(DeltaTime);
+	}
+
+	if (BandwidthProfiler.IsRecording())
+	{
+		BandwidthProfiler.Tick(DeltaTime);
+	}
+
 	Super::TickFlush(DeltaTime);
 }
 
+void USpatialNetDriver::UpdateMulticastRelevancy()
+{
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialUpdateMulticastRelevancy);
+
+	TArray<FVector> ViewLocations;
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		APlayerController* PlayerController = Iterator->Get();
+		if (PlayerController != nullptr && PlayerController->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+
+	if (ViewLocations.Num() == 0)
+	{
+		return;
+	}
+
+	for (const TPair<Worker_EntityId_Key, USpatialActorChannel*>& EntityChannelPair : EntityToActorChannel)
+	{
+		USpatialActorChannel* Channel = EntityChannelPair.Value;
+		AActor* Actor = Channel != nullptr ? Channel->Actor : nullptr;
+		if (Actor == nullptr || Actor->IsPendingKill())
+		{
+			continue;
+		}
+
+		const FClassInfo& Info = ClassInfoManager->GetOrCreateClassInfoByClass(Actor->GetClass());
+
+		bool bCanCull = CanCullMulticastRPCs(Info);
+		for (const auto& SubobjectInfoPair : Info.SubobjectInfo)
+		{
+			bCanCull |= CanCullMulticastRPCs(SubobjectInfoPair.Value.Get());
+		}
+
+		if (!bCanCull)
+		{
+			continue;
+		}
+
+		// Like native relevancy, actors which are always relevant or owned by this client are never culled.
+		bool bCulled = !Actor->bAlwaysRelevant && !Channel->IsOwnedByWorker();
+		for (int32 ViewIndex = 0; bCulled && ViewIndex < ViewLocations.Num(); ViewIndex++)
+		{
+			bCulled = !Actor->IsWithinNetRelevancyDistance(ViewLocations[ViewIndex]);
+		}
+
+		if (bCulled != Channel->AreMulticastsCulled())
+		{
+			UE_LOG(LogSpatialOSNetDriver, Verbose, TEXT("%s multicast RPCs of %s (entity: %lld)"), bCulled ? TEXT("Culling") : TEXT("Restoring"), *Actor->GetName(), EntityChannelPair.Key);
+
+			Channel->SetMulticastsCulled(bCulled);
+			Sender->SendComponentInterest(Actor, EntityChannelPair.Key);
+		}
+	}
+}
+
 USpatialNetConnection * USpatialNetDriver::GetSpatialOSNetConnection() const
 {
 	if (ServerConnection)
@@ -1262,10 +1421,70 @@ bool USpatialNetDriver::Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& A
 	{
 		return HandleNetDumpCrossServerRPCCommand(Cmd, Ar);
 	}
+	else if (FParse::Command(&Cmd, TEXT("SPATIALBANDWIDTH")))
+	{
+		return HandleSpatialBandwidthCommand(Cmd, Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("SPATIALLATENCY")))
+	{
+		return HandleSpatialLatencyCommand(Cmd, Ar);
+	}
 #endif // !UE_BUILD_SHIPPING
 	return UNetDriver::Exec(InWorld, Cmd, Ar);
 }
 
+#if !UE_BUILD_SHIPPING
+// SPATIALBANDWIDTH START [WindowSeconds] | STOP | RESET | DUMP [MaxEntries]
+bool USpatialNetDriver::HandleSpatialBandwidthCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (FParse::Command(&Cmd, TEXT("START")))
+	{
+		BandwidthProfiler.StartRecording(FCString::Atof(Cmd));
+		Ar.Logf(TEXT("Spatial bandwidth profiler started."));
+	}
+	else if (FParse::Command(&Cmd, TEXT("STOP")))
+	{
+		BandwidthProfiler.StopRecording();
+		Ar.Logf(TEXT("Spatial bandwidth profiler stopped."));
+	}
+	else if (FParse::Command(&Cmd, TEXT("RESET")))
+	{
+		BandwidthProfiler.Reset();
+		Ar.Logf(TEXT("Spatial bandwidth profiler reset."));
+	}
+	else if (FParse::Command(&Cmd, TEXT("DUMP")))
+	{
+		BandwidthProfiler.Dump(Ar, FCString::Atoi(Cmd));
+	}
+	else
+	{
+		Ar.Logf(TEXT("Usage: SPATIALBANDWIDTH START [WindowSeconds] | STOP | RESET | DUMP [MaxEntries]"));
+	}
+
+	return true;
+}
+
+// SPATIALLATENCY DUMP | RESET
+bool USpatialNetDriver::HandleSpatialLatencyCommand(const TCHAR* Cmd, FOutputDevice& Ar)
+{
+	if (FParse::Command(&Cmd, TEXT("DUMP")))
+	{
+		LatencyTracer.Dump(Ar);
+	}
+	else if (FParse::Command(&Cmd, TEXT("RESET")))
+	{
+		LatencyTracer.Reset();
+		Ar.Logf(TEXT("Spatial latency traces reset."));
+	}
+	else
+	{
+		Ar.Logf(TEXT("Usage: SPATIALLATENCY DUMP | RESET"));
+	}
+
+	return true;
+}
+#endif // !UE_BUILD_SHIPPING
+
 // This function is literally a copy paste of UNetDriver::HandleNetDumpServerRPCCommand. Didn't want to refactor to avoid divergence from engine.
 #if !UE_BUILD_SHIPPING
 bool USpatialNetDriver::HandleNetDumpCrossServerRPCCommand(const TCHAR* Cmd, FOutputDevice& Ar)
@@ -1424,113 +1643,6 @@ void USpatialNetDriver::WipeWorld(const USpatialNetDriver::PostWorldWipeDelegate
 	}
 }
 
-#if !UE_BUILD_SHIPPING
-uint32 USpatialNetDriver::GetNextReliableRPCId(AActor* Actor, ESchemaComponentType RPCType, UObject* TargetObject)
-{
-	if (!ReliableRPCIdMap.Contains(Actor))
-	{
-		ReliableRPCIdMap.Add(Actor);
-	}
-	FRPCTypeToReliableRPCIdMap& ReliableRPCIds = ReliableRPCIdMap[Actor];
-
-	if (FReliableRPCId* RPCIdEntry = ReliableRPCIds.Find(RPCType))
-	{
-		if (!RPCIdEntry->WorkerId.IsEmpty())
-		{
-			// We previously used to receive RPCs of this type, now we're about to send one, so we reset the reliable RPC index.
-			// This should only be possible for CrossServer RPCs.
-			check(RPCType == SCHEMA_CrossServerRPC);
-			UE_LOG(LogSpatialOSNetDriver, Verbose, TEXT("Actor %s, object %s: Used to receive reliable CrossServer RPCs from worker %s, now about to send one. The entity must have crossed boundary."),
-				*Actor->GetName(), *TargetObject->GetName(), *RPCIdEntry->WorkerId);
-			RPCIdEntry->WorkerId = FString();
-			RPCIdEntry->RPCId = 0;
-		}
-	}
-	else
-	{
-		// Add an entry for this RPC type with empty WorkerId and RPCId = 0
-		ReliableRPCIds.Add(RPCType);
-	}
-
-	return ++ReliableRPCIds[RPCType].RPCId;
-}
-
-void USpatialNetDriver::OnReceivedReliableRPC(AActor* Actor, ESchemaComponentType RPCType, FString WorkerId, uint32 RPCId, UObject* TargetObject, UFunction* Function)
-{
-	check(!WorkerId.IsEmpty());
-
-	if (!ReliableRPCIdMap.Contains(Actor))
-	{
-		ReliableRPCIdMap.Add(Actor);
-	}
-	FRPCTypeToReliableRPCIdMap& ReliableRPCIds = ReliableRPCIdMap[Actor];
-
-	if (FReliableRPCId* RPCIdEntry = ReliableRPCIds.Find(RPCType))
-	{
-		if (WorkerId != RPCIdEntry->WorkerId)
-		{
-			if (RPCIdEntry->WorkerId.IsEmpty())
-			{
-				// We previously used to send RPCs of this type, now we received one. This should only be possible for CrossServer RPCs.
-				check(RPCType == SCHEMA_CrossServerRPC);
-				UE_LOG(LogSpatialOSNetDriver, Verbose, TEXT("Actor %s, object %s: Used to send reliable CrossServer RPCs, now received one from worker %s. The entity must have crossed boundary."),
-					*Actor->GetName(), *TargetObject->GetName(), *WorkerId);
-			}
-			else
-			{
-				// We received an RPC from a different worker than the one we used to receive RPCs of this type from.
-				UE_LOG(LogSpatialOSNetDriver, Verbose, TEXT("Actor %s, object %s: Received a reliable %s RPC from a different worker %s. Previously received from worker %s."),
-					*Actor->GetName(), *TargetObject->GetName(), *RPCSchemaTypeToString(RPCType), *WorkerId, *RPCIdEntry->WorkerId);
-			}
-			RPCIdEntry->WorkerId = WorkerId;
-		}
-		else if (RPCId != RPCIdEntry->RPCId + 1)
-		{
-			if (RPCId < RPCIdEntry->RPCId)
-			{
-				UE_LOG(LogSpatialOSNetDriver, Verbose, TEXT("Actor %s: Reliable %s RPC received out of order! Previously received RPC: %s, target %s, index %d. Now received: %s, target %s, index %d. Sender: %s"),
-					*Actor->GetName(), *RPCSchemaTypeToString(RPCType), *RPCIdEntry->LastRPCName, *RPCIdEntry->LastRPCTarget, RPCIdEntry->RPCId, *Function->GetName(), *TargetObject->GetName(), RPCId, *WorkerId);
-			}
-			else if (RPCId == RPCIdEntry->RPCId)
-			{
-				UE_LOG(LogSpatialOSNetDriver, Verbose, TEXT("Actor %s: Reliable %s RPC index duplicated! Previously received RPC: %s, target %s, index %d. Now received: %s, target %s, index %d. Sender: %s"),
-					*Actor->GetName(), *RPCSchemaTypeToString(RPCType), *RPCIdEntry->LastRPCName, *RPCIdEntry->LastRPCTarget, RPCIdEntry->RPCId, *Function->GetName(), *TargetObject->GetName(), RPCId, *WorkerId);
-			}
-			else
-			{
-				UE_LOG(LogSpatialOSNetDriver, Verbose, TEXT("Actor %s: One or more reliable %s RPCs skipped! Previously received RPC: %s, target %s, index %d. Now received: %s, target %s, index %d. Sender: %s"),
-					*Actor->GetName(), *RPCSchemaTypeToString(RPCType), *RPCIdEntry->LastRPCName, *RPCIdEntry->LastRPCTarget, RPCIdEntry->RPCId, *Function->GetName(), *TargetObject->GetName(), RPCId, *WorkerId);
-			}
-		}
-
-		RPCIdEntry->RPCId = RPCId;
-		RPCIdEntry->LastRPCTarget = TargetObject->GetName();
-		RPCIdEntry->LastRPCName = Function->GetName();
-	}
-	else
-	{
-		ReliableRPCIds.Add(RPCType, FReliableRPCId(WorkerId, RPCId, TargetObject->GetName(), Function->GetName()));
-	}
-}
-
-void USpatialNetDriver::OnRPCAuthorityGained(AActor* Actor, ESchemaComponentType RPCType)
-{
-	// When we gain authority on an RPC component of an actor that we previously received RPCs for, reset the reliable RPC counter.
-	// This is to account for the case where the actor crosses to another worker, receives a couple of reliable RPCs, and comes back
-	// to the original worker.
-	if (FRPCTypeToReliableRPCIdMap* ReliableRPCIds = ReliableRPCIdMap.Find(Actor))
-	{
-		if (ReliableRPCIds->Contains(RPCType))
-		{
-			UE_LOG(LogSpatialOSNetDriver, Verbose, TEXT("Actor %s: Gained authority over %s RPC component. Resetting previous reliable RPC counter."),
-				*Actor->GetName(), *RPCSchemaTypeToString(RPCType));
-			ReliableRPCIds->Remove(RPCType);
-		}
-	}
-}
-
-#endif // !UE_BUILD_SHIPPING
-
 void USpatialNetDriver::DelayedSendDeleteEntityRequest(Worker_EntityId EntityId, float Delay)
 {
 	FTimerHandle RetryTimer;
@@ -3,12 +3,16 @@
 #include "Interop/SpatialClassInfoManager.h"
 
 #include "AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
 #include "Engine/Blueprint.h"
 #include "Engine/BlueprintGeneratedClass.h"
 #include "Engine/SCS_Node.h"
 #include "GameFramework/Actor.h"
 #include "Misc/MessageDialog.h"
+#include "Net/RepLayout.h"
 #include "UObject/Class.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
 #include "UObject/UObjectIterator.h"
 
 #include "EngineClasses/SpatialNetDriver.h"
@@ -17,9 +21,127 @@
 
 DEFINE_LOG_CATEGORY(LogSpatialClassInfoManager);
 
+namespace
+{
+
+// Whether a handover property can be compared and copied bytewise. Bitfield bools share their byte with other properties,
+// so they have to go through UBoolProperty.
+bool IsPlainOldDataHandoverProperty(UProperty* Property)
+{
+	if (!(Property->PropertyFlags & CPF_IsPlainOldData))
+	{
+		return false;
+	}
+
+	if (UBoolProperty* BoolProperty = Cast<UBoolProperty>(Property))
+	{
+		return BoolProperty->IsNativeBool();
+	}
+
+	return true;
+}
+
+}
+
+ESchemaFieldDecoder GetSchemaFieldDecoder(UProperty* Property)
+{
+	if (Property == nullptr)
+	{
+		return ESchemaFieldDecoder::Unknown;
+	}
+
+	if (Property->IsA<UStructProperty>())
+	{
+		return ESchemaFieldDecoder::Struct;
+	}
+	if (Property->IsA<UBoolProperty>())
+	{
+		return ESchemaFieldDecoder::Bool;
+	}
+	if (Property->IsA<UFloatProperty>())
+	{
+		return ESchemaFieldDecoder::Float;
+	}
+	if (Property->IsA<UDoubleProperty>())
+	{
+		return ESchemaFieldDecoder::Double;
+	}
+	if (Property->IsA<UInt8Property>())
+	{
+		return ESchemaFieldDecoder::Int8;
+	}
+	if (Property->IsA<UInt16Property>())
+	{
+		return ESchemaFieldDecoder::Int16;
+	}
+	if (Property->IsA<UIntProperty>())
+	{
+		return ESchemaFieldDecoder::Int32;
+	}
+	if (Property->IsA<UInt64Property>())
+	{
+		return ESchemaFieldDecoder::Int64;
+	}
+	if (Property->IsA<UByteProperty>())
+	{
+		return ESchemaFieldDecoder::UInt8;
+	}
+	if (Property->IsA<UUInt16Property>())
+	{
+		return ESchemaFieldDecoder::UInt16;
+	}
+	if (Property->IsA<UUInt32Property>())
+	{
+		return ESchemaFieldDecoder::UInt32;
+	}
+	if (Property->IsA<UUInt64Property>())
+	{
+		return ESchemaFieldDecoder::UInt64;
+	}
+	if (Property->IsA<UObjectPropertyBase>())
+	{
+		return ESchemaFieldDecoder::Object;
+	}
+	if (Property->IsA<UNameProperty>())
+	{
+		return ESchemaFieldDecoder::Name;
+	}
+	if (Property->IsA<UStrProperty>())
+	{
+		return ESchemaFieldDecoder::String;
+	}
+	if (Property->IsA<UTextProperty>())
+	{
+		return ESchemaFieldDecoder::Text;
+	}
+	if (Property->IsA<UArrayProperty>())
+	{
+		return ESchemaFieldDecoder::Array;
+	}
+	if (UEnumProperty* EnumProperty = Cast<UEnumProperty>(Property))
+	{
+		// Enums smaller than 4 bytes are sent as uint32, larger ones as their underlying type.
+		switch (EnumProperty->ElementSize)
+		{
+		case 1:
+			return ESchemaFieldDecoder::UInt8;
+		case 2:
+			return ESchemaFieldDecoder::UInt16;
+		default:
+			return GetSchemaFieldDecoder(EnumProperty->GetUnderlyingProperty());
+		}
+	}
+
+	return ESchemaFieldDecoder::Unknown;
+}
+
 void USpatialClassInfoManager::Init(USpatialNetDriver* InNetDriver)
 {
 	NetDriver = InNetDriver;
+
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectsReplaced.AddUObject(this, &USpatialClassInfoManager::OnObjectsReplaced);
+#endif
 	
 	TSoftObjectPtr<USchemaDatabase> SchemaDatabasePtr(FSoftObjectPath(TEXT("/Game/Spatial/SchemaDatabase.SchemaDatabase")));
 	SchemaDatabasePtr.LoadSynchronous();
@@ -30,7 +152,70 @@ void USpatialClassInfoManager::Init(USpatialNetDriver* InNetDriver)
 		FMessageDialog::Debugf(FText::FromString(TEXT("SchemaDatabase not found! No classes will be supported for SpatialOS replication.")));
 		return;
 	}
+
+	bPackedComponentIds = SchemaDatabase->ComponentIdStride == SCHEMA_Count;
+	if (bPackedComponentIds)
+	{
+		ComponentSlots.SetNum((SchemaDatabase->NextAvailableComponentId - SpatialConstants::STARTING_GENERATED_COMPONENT_ID) / SCHEMA_Count);
+	}
+	else
+	{
+		UE_LOG(LogSpatialClassInfoManager, Warning, TEXT("SchemaDatabase was generated with an old component id layout. Regenerate schema to speed up component lookups."));
+	}
+
+	if (NetDriver->bPrecomputeClassInfos)
+	{
+		PrecomputeClassInfos();
+	}
+}
+
+UClass* USpatialClassInfoManager::GetActorClassByPath(const FString& ClassPath)
+{
+	if (TWeakObjectPtr<UClass>* CachedClass = ClassPathToActorClass.Find(ClassPath))
+	{
+		if (UClass* Class = CachedClass->Get())
+		{
+			return Class;
+		}
+	}
+
+	UClass* Class = FindObject<UClass>(ANY_PACKAGE, *ClassPath);
+	if (Class == nullptr || !Class->IsChildOf<AActor>())
+	{
+		// Not cached, as the class may still be loaded later.
+		return nullptr;
+	}
+
+	ClassPathToActorClass.Add(ClassPath, Class);
+	return Class;
+}
+
+#if WITH_EDITOR
+void USpatialClassInfoManager::OnObjectsReplaced(const TMap<UObject*, UObject*>& OldToNewInstanceMap)
+{
+	ClassPathToActorClass.Empty();
+
+	// Rebuild the class info of replaced classes, so their component ids resolve to the new class. The old entries stay in the
+	// class info table, as actor channels may still refer to them by index.
+	for (const TPair<UObject*, UObject*>& OldToNew : OldToNewInstanceMap)
+	{
+		UClass* OldClass = Cast<UClass>(OldToNew.Key);
+		if (OldClass == nullptr || !ClassInfoMap.Contains(OldClass))
+		{
+			continue;
+		}
+
+		ClassInfoMap.Remove(OldClass);
+		PrecomputedClasses.Remove(OldClass);
+
+		UClass* NewClass = Cast<UClass>(OldToNew.Value);
+		if (NewClass != nullptr && IsSupportedClass(NewClass) && !ClassInfoMap.Contains(NewClass))
+		{
+			CreateClassInfoForClass(NewClass);
+		}
+	}
 }
+#endif
 
 FORCEINLINE UClass* ResolveClass(FString& ClassPath)
 {
@@ -43,10 +228,72 @@ FORCEINLINE UClass* ResolveClass(FString& ClassPath)
 void USpatialClassInfoManager::CreateClassInfoForClass(UClass* Class)
 {
 	checkf(IsSupportedClass(Class), TEXT("Could not find class in schema database: %s"), *Class->GetPathName());
+	check(IsInGameThread());
+
+	if (bClassInfosPrecomputed)
+	{
+		UE_LOG(LogSpatialClassInfoManager, Log, TEXT("Class %s wasn't precomputed, creating its class info now."), *Class->GetPathName());
+	}
 
-	TSharedRef<FClassInfo> Info = ClassInfoMap.Add(Class, MakeShared<FClassInfo>());
+	TSharedRef<FClassInfo> Info = MakeShared<FClassInfo>();
 	Info->Class = Class;
 
+	FillClassInfoFromReflection(Info.Get(), Class);
+	RegisterClassInfo(Info);
+	CreateSubobjectInfos(Info.Get());
+}
+
+void USpatialClassInfoManager::PrecomputeClassInfos()
+{
+	double PrecomputeStartTime = FPlatformTime::Seconds();
+
+	// Loading classes has to happen on the game thread, so resolve every class up front.
+	for (const auto& ClassPathSchemaPair : SchemaDatabase->ClassPathToSchema)
+	{
+		UClass* Class = FSoftClassPath(ClassPathSchemaPair.Key).TryLoadClass<UObject>();
+		if (Class == nullptr)
+		{
+			UE_LOG(LogSpatialClassInfoManager, Warning, TEXT("Failed to load class at path %s, it will not have precomputed class info."), *ClassPathSchemaPair.Key);
+			continue;
+		}
+
+		PrecomputedClasses.Add(Class);
+	}
+
+	// Walking the reflection data of loaded classes is read-only, so it can be spread over worker threads.
+	TArray<TSharedRef<FClassInfo>> Infos;
+	Infos.Reserve(PrecomputedClasses.Num());
+	for (UClass* Class : PrecomputedClasses)
+	{
+		TSharedRef<FClassInfo> Info = MakeShared<FClassInfo>();
+		Info->Class = Class;
+		Infos.Add(Info);
+	}
+
+	ParallelFor(Infos.Num(), [this, &Infos](int32 Index)
+	{
+		FillClassInfoFromReflection(Infos[Index].Get(), PrecomputedClasses[Index]);
+	});
+
+	// Subobject infos are copies of their class' info, so register every class before creating them.
+	ClassInfoTable.Reserve(ClassInfoTable.Num() + Infos.Num());
+	for (TSharedRef<FClassInfo>& Info : Infos)
+	{
+		RegisterClassInfo(Info);
+	}
+
+	for (TSharedRef<FClassInfo>& Info : Infos)
+	{
+		CreateSubobjectInfos(Info.Get());
+	}
+
+	bClassInfosPrecomputed = true;
+
+	UE_LOG(LogSpatialClassInfoManager, Log, TEXT("Precomputed class info for %d classes in %.2f ms."), Infos.Num(), (FPlatformTime::Seconds() - PrecomputeStartTime) * 1000.0);
+}
+
+void USpatialClassInfoManager::FillClassInfoFromReflection(FClassInfo& Info, UClass* Class)
+{
 	TArray<UFunction*> RelevantClassFunctions = improbable::GetClassRPCFunctions(Class);
 
 	for (UFunction* RemoteFunction : RelevantClassFunctions)
@@ -73,14 +320,19 @@ void USpatialClassInfoManager::CreateClassInfoForClass(UClass* Class)
 			checkNoEntry();
 		}
 
-		TArray<UFunction*>& RPCArray = Info->RPCs.FindOrAdd(RPCType);
+		TArray<UFunction*>& RPCArray = Info.RPCs.FindOrAdd(RPCType);
 
 		FRPCInfo RPCInfo;
 		RPCInfo.Type = RPCType;
 		RPCInfo.Index = RPCArray.Num();
 
 		RPCArray.Add(RemoteFunction);
-		Info->RPCInfoMap.Add(RemoteFunction, RPCInfo);
+		Info.RPCInfoMap.Add(RemoteFunction, RPCInfo);
+
+		if (RPCType == SCHEMA_NetMulticastRPC && RemoteFunction->HasAnyFunctionFlags(FUNC_NetReliable))
+		{
+			Info.bHasReliableMulticastRPCs = true;
+		}
 	}
 
 	for (TFieldIterator<UProperty> PropertyIt(Class); PropertyIt; ++PropertyIt)
@@ -92,12 +344,15 @@ void USpatialClassInfoManager::CreateClassInfoForClass(UClass* Class)
 			for (int32 ArrayIdx = 0; ArrayIdx < PropertyIt->ArrayDim; ++ArrayIdx)
 			{
 				FHandoverPropertyInfo HandoverInfo;
-				HandoverInfo.Handle = Info->HandoverProperties.Num() + 1; // 1-based index
+				HandoverInfo.Handle = Info.HandoverProperties.Num() + 1; // 1-based index
 				HandoverInfo.Offset = Property->GetOffset_ForGC() + Property->ElementSize * ArrayIdx;
 				HandoverInfo.ArrayIdx = ArrayIdx;
 				HandoverInfo.Property = Property;
+				HandoverInfo.Decoder = GetSchemaFieldDecoder(Property);
+				HandoverInfo.ShadowOffset = 0;
+				HandoverInfo.bIsPlainOldData = IsPlainOldDataHandoverProperty(Property);
 
-				Info->HandoverProperties.Add(HandoverInfo);
+				Info.HandoverProperties.Add(HandoverInfo);
 			}
 		}
 
@@ -109,9 +364,67 @@ void USpatialClassInfoManager::CreateClassInfoForClass(UClass* Class)
 				InterestInfo.Offset = Property->GetOffset_ForGC() + Property->ElementSize * ArrayIdx;
 				InterestInfo.Property = Property;
 
-				Info->InterestProperties.Add(InterestInfo);
+				Info.InterestProperties.Add(InterestInfo);
+			}
+		}
+	}
+
+	BuildHandoverShadowLayout(Info);
+}
+
+void USpatialClassInfoManager::BuildHandoverShadowLayout(FClassInfo& Info)
+{
+	int32 ShadowSize = 0;
+	for (int32 PropertyIndex = 0; PropertyIndex < Info.HandoverProperties.Num(); PropertyIndex++)
+	{
+		FHandoverPropertyInfo& PropertyInfo = Info.HandoverProperties[PropertyIndex];
+		const int32 ElementSize = PropertyInfo.Property->ElementSize;
+
+		if (PropertyInfo.bIsPlainOldData && Info.HandoverShadowRuns.Num() > 0)
+		{
+			FHandoverShadowRun& LastRun = Info.HandoverShadowRuns.Last();
+			if (LastRun.bIsPlainOldData && LastRun.Offset + LastRun.Size == PropertyInfo.Offset)
+			{
+				PropertyInfo.ShadowOffset = LastRun.ShadowOffset + LastRun.Size;
+				LastRun.Size += ElementSize;
+				LastRun.NumProperties++;
+				ShadowSize = PropertyInfo.ShadowOffset + ElementSize;
+				continue;
 			}
 		}
+
+		// Elements of a static array stay contiguous, since InitializeValue on the first element initializes the whole array.
+		ShadowSize = Align(ShadowSize, PropertyInfo.Property->GetMinAlignment());
+		PropertyInfo.ShadowOffset = ShadowSize;
+		ShadowSize += ElementSize;
+
+		FHandoverShadowRun Run;
+		Run.Offset = PropertyInfo.Offset;
+		Run.ShadowOffset = PropertyInfo.ShadowOffset;
+		Run.Size = ElementSize;
+		Run.FirstProperty = PropertyIndex;
+		Run.NumProperties = 1;
+		Run.bIsPlainOldData = PropertyInfo.bIsPlainOldData;
+		Info.HandoverShadowRuns.Add(Run);
+	}
+
+	Info.HandoverShadowSize = ShadowSize;
+}
+
+void USpatialClassInfoManager::RegisterClassInfo(TSharedRef<FClassInfo> Info)
+{
+	UClass* Class = Info->Class.Get();
+	check(Class);
+
+	Info->ClassIndex = ClassInfoTable.Add(Info);
+	ClassInfoMap.Add(Class, Info);
+
+	// The rep layout is created on the game thread, so the replicated decoders are filled in here rather than from reflection.
+	TSharedPtr<FRepLayout> RepLayout = NetDriver->GetObjectClassRepLayout(Class);
+	Info->RepCmdDecoders.Reserve(RepLayout->Cmds.Num());
+	for (const FRepLayoutCmd& Cmd : RepLayout->Cmds)
+	{
+		Info->RepCmdDecoders.Add(GetSchemaFieldDecoder(Cmd.Property));
 	}
 
 	ForAllSchemaComponentTypes([&](ESchemaComponentType Type)
@@ -120,11 +433,15 @@ void USpatialClassInfoManager::CreateClassInfoForClass(UClass* Class)
 		if (ComponentId != 0)
 		{
 			Info->SchemaComponents[Type] = ComponentId;
-			ComponentToClassInfoMap.Add(ComponentId, Info);
-			ComponentToOffsetMap.Add(ComponentId, 0);
-			ComponentToCategoryMap.Add(ComponentId, (ESchemaComponentType)Type);
+			AddComponentId(ComponentId, Type, Info, 0);
 		}
 	});
+}
+
+void USpatialClassInfoManager::CreateSubobjectInfos(FClassInfo& Info)
+{
+	UClass* Class = Info.Class.Get();
+	check(Class);
 
 	for (auto& SubobjectClassDataPair : SchemaDatabase->ClassPathToSchema[Class->GetPathName()].SubobjectData)
 	{
@@ -145,16 +462,76 @@ void USpatialClassInfoManager::CreateClassInfoForClass(UClass* Class)
 			if (ComponentId != 0)
 			{
 				ActorSubobjectInfo->SchemaComponents[Type] = ComponentId;
-				ComponentToClassInfoMap.Add(ComponentId, ActorSubobjectInfo);
-				ComponentToOffsetMap.Add(ComponentId, Offset);
-				ComponentToCategoryMap.Add(ComponentId, ESchemaComponentType(Type));
+				AddComponentId(ComponentId, Type, ActorSubobjectInfo, Offset);
 			}
 		});
 
-		Info->SubobjectInfo.Add(Offset, ActorSubobjectInfo);
+		Info.SubobjectInfo.Add(Offset, ActorSubobjectInfo);
 	}
 }
 
+void USpatialClassInfoManager::AddComponentId(Worker_ComponentId ComponentId, ESchemaComponentType Type, TSharedRef<FClassInfo> Info, uint32 Offset)
+{
+	FComponentSlot ComponentSlot;
+	ComponentSlot.Info = Info;
+	ComponentSlot.Offset = Offset;
+
+	if (bPackedComponentIds)
+	{
+		checkf(ComponentId >= SpatialConstants::STARTING_GENERATED_COMPONENT_ID && (ComponentId - SpatialConstants::STARTING_GENERATED_COMPONENT_ID) % SCHEMA_Count == Type,
+			TEXT("Component %d of class %s doesn't match the packed component id layout"), ComponentId, *Info->Class->GetPathName());
+
+		const int32 SlotIndex = (ComponentId - SpatialConstants::STARTING_GENERATED_COMPONENT_ID) / SCHEMA_Count;
+		if (SlotIndex >= ComponentSlots.Num())
+		{
+			ComponentSlots.SetNum(SlotIndex + 1);
+		}
+
+		ComponentSlots[SlotIndex] = ComponentSlot;
+	}
+	else
+	{
+		UnpackedComponentIds.Add(ComponentId, TPair<FComponentSlot, ESchemaComponentType>(ComponentSlot, Type));
+	}
+}
+
+const USpatialClassInfoManager::FComponentSlot* USpatialClassInfoManager::FindComponentSlot(Worker_ComponentId ComponentId, ESchemaComponentType& OutType) const
+{
+	if (!bPackedComponentIds)
+	{
+		if (const TPair<FComponentSlot, ESchemaComponentType>* Entry = UnpackedComponentIds.Find(ComponentId))
+		{
+			OutType = Entry->Value;
+			return &Entry->Key;
+		}
+
+		return nullptr;
+	}
+
+	if (ComponentId < SpatialConstants::STARTING_GENERATED_COMPONENT_ID)
+	{
+		return nullptr;
+	}
+
+	const uint32 SlotIndex = (ComponentId - SpatialConstants::STARTING_GENERATED_COMPONENT_ID) / SCHEMA_Count;
+	if (SlotIndex >= (uint32)ComponentSlots.Num())
+	{
+		return nullptr;
+	}
+
+	const FComponentSlot& ComponentSlot = ComponentSlots[SlotIndex];
+	const ESchemaComponentType Type = ESchemaComponentType((ComponentId - SpatialConstants::STARTING_GENERATED_COMPONENT_ID) % SCHEMA_Count);
+
+	// The slot may belong to a class whose info hasn't been created yet, or not use every type.
+	if (!ComponentSlot.Info.IsValid() || ComponentSlot.Info->SchemaComponents[Type] != ComponentId)
+	{
+		return nullptr;
+	}
+
+	OutType = Type;
+	return &ComponentSlot;
+}
+
 bool USpatialClassInfoManager::IsSupportedClass(UClass* Class) const
 {
 	return SchemaDatabase->ClassPathToSchema.Contains(Class->GetPathName());
@@ -203,13 +580,19 @@ const FClassInfo& USpatialClassInfoManager::GetOrCreateClassInfoByObject(UObject
 
 const FClassInfo& USpatialClassInfoManager::GetClassInfoByComponentId(Worker_ComponentId ComponentId) const
 {
-	TSharedRef<FClassInfo> Info = ComponentToClassInfoMap.FindChecked(ComponentId);
-	return Info.Get();
+	ESchemaComponentType Type;
+	const FComponentSlot* ComponentSlot = FindComponentSlot(ComponentId, Type);
+	checkf(ComponentSlot, TEXT("Could not find class info for component %d"), ComponentId);
+	return *ComponentSlot->Info;
 }
 
 UClass* USpatialClassInfoManager::GetClassByComponentId(Worker_ComponentId ComponentId)
 {
-	TSharedRef<FClassInfo> Info = ComponentToClassInfoMap.FindChecked(ComponentId);
+	ESchemaComponentType Type;
+	const FComponentSlot* ComponentSlot = FindComponentSlot(ComponentId, Type);
+	checkf(ComponentSlot, TEXT("Could not find class info for component %d"), ComponentId);
+
+	TSharedPtr<FClassInfo> Info = ComponentSlot->Info;
 	if (UClass* Class = Info->Class.Get())
 	{
 		return Class;
@@ -221,7 +604,7 @@ UClass* USpatialClassInfoManager::GetClassByComponentId(Worker_ComponentId Compo
 		// The weak pointer to the class stored in the FClassInfo will be the same as the one used as the key in ClassInfoMap, so we can use it to clean up the old entry.
 		ClassInfoMap.Remove(Info->Class);
 
-		// The old references in the other maps (ComponentToClassInfoMap etc) will be replaced by reloading the info (as a part of LoadClassForComponent).
+		// The old references in the component slots will be replaced by reloading the info (as a part of LoadClassForComponent).
 	}
 
 	return nullptr;
@@ -229,9 +612,10 @@ UClass* USpatialClassInfoManager::GetClassByComponentId(Worker_ComponentId Compo
 
 bool USpatialClassInfoManager::GetOffsetByComponentId(Worker_ComponentId ComponentId, uint32& OutOffset)
 {
-	if (uint32* Offset = ComponentToOffsetMap.Find(ComponentId))
+	ESchemaComponentType Type;
+	if (const FComponentSlot* ComponentSlot = FindComponentSlot(ComponentId, Type))
 	{
-		OutOffset = *Offset;
+		OutOffset = ComponentSlot->Offset;
 		return true;
 	}
 
@@ -240,9 +624,10 @@ bool USpatialClassInfoManager::GetOffsetByComponentId(Worker_ComponentId Compone
 
 ESchemaComponentType USpatialClassInfoManager::GetCategoryByComponentId(Worker_ComponentId ComponentId)
 {
-	if (ESchemaComponentType* Category = ComponentToCategoryMap.Find(ComponentId))
+	ESchemaComponentType Type;
+	if (FindComponentSlot(ComponentId, Type) != nullptr)
 	{
-		return *Category;
+		return Type;
 	}
 
 	return ESchemaComponentType::SCHEMA_Invalid;
@@ -7,9 +7,23 @@
 #include "Interop/SpatialReceiver.h"
 #include "Interop/SpatialStaticComponentView.h"
 #include "Interop/SpatialWorkerFlags.h"
+#include "Utils/SpatialNetStats.h"
 
 DEFINE_LOG_CATEGORY(LogSpatialView);
 
+DECLARE_CYCLE_STAT(TEXT("ProcessOps"), STAT_SpatialDispatcherProcessOps, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("Op: CriticalSection"), STAT_SpatialDispatcherCriticalSection, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("Op: AddEntity"), STAT_SpatialDispatcherAddEntity, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("Op: RemoveEntity"), STAT_SpatialDispatcherRemoveEntity, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("Op: AddComponent"), STAT_SpatialDispatcherAddComponent, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("Op: ComponentUpdate"), STAT_SpatialDispatcherComponentUpdate, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("Op: CommandRequest"), STAT_SpatialDispatcherCommandRequest, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("Op: CommandResponse"), STAT_SpatialDispatcherCommandResponse, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("Op: AuthorityChange"), STAT_SpatialDispatcherAuthorityChange, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("Op: WorldCommandResponse"), STAT_SpatialDispatcherWorldCommandResponse, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("ProcessQueuedComponentUpdates"), STAT_SpatialDispatcherProcessQueuedComponentUpdates, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("SpatialViewTick"), STAT_SpatialDispatcherSpatialViewTick, STATGROUP_SpatialNet);
+
 void USpatialDispatcher::Init(USpatialNetDriver* InNetDriver)
 {
 	NetDriver = InNetDriver;
@@ -19,7 +33,7 @@ void USpatialDispatcher::Init(USpatialNetDriver* InNetDriver)
 
 void USpatialDispatcher::ProcessOps(Worker_OpList* OpList)
 {
-	TArray<Worker_Op*> QueuedComponentUpdateOps;
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherProcessOps);
 
 	for (size_t i = 0; i < OpList->op_count; ++i)
 	{
@@ -28,59 +42,99 @@ void USpatialDispatcher::ProcessOps(Worker_OpList* OpList)
 		{
 		// Critical Section
 		case WORKER_OP_TYPE_CRITICAL_SECTION:
+		{
+			SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherCriticalSection);
+			if (Op->critical_section.in_critical_section != 0)
+			{
+				ReserveCriticalSection(OpList, i + 1);
+			}
 			Receiver->OnCriticalSection(Op->critical_section.in_critical_section != 0);
 			break;
+		}
 
 		// Entity Lifetime
 		case WORKER_OP_TYPE_ADD_ENTITY:
+		{
+			SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherAddEntity);
 			Receiver->OnAddEntity(Op->add_entity);
 			break;
+		}
 		case WORKER_OP_TYPE_REMOVE_ENTITY:
+		{
+			SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherRemoveEntity);
 			Receiver->OnRemoveEntity(Op->remove_entity);
 			StaticComponentView->OnRemoveEntity(Op->remove_entity);
 			break;
+		}
 
 		// Components
 		case WORKER_OP_TYPE_ADD_COMPONENT:
+		{
+			SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherAddComponent);
 			StaticComponentView->OnAddComponent(Op->add_component);
 			Receiver->OnAddComponent(Op->add_component);
 			break;
+		}
 		case WORKER_OP_TYPE_REMOVE_COMPONENT:
 			break;
 		case WORKER_OP_TYPE_COMPONENT_UPDATE:
-			QueuedComponentUpdateOps.Add(Op);
+		{
+			SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherComponentUpdate);
+			QueueComponentUpdate(&Op->component_update);
 			StaticComponentView->OnComponentUpdate(Op->component_update);
 			break;
+		}
 
 		// Commands
 		case WORKER_OP_TYPE_COMMAND_REQUEST:
+		{
+			SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherCommandRequest);
 			Receiver->OnCommandRequest(Op->command_request);
 			break;
+		}
 		case WORKER_OP_TYPE_COMMAND_RESPONSE:
+		{
+			SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherCommandResponse);
 			Receiver->OnCommandResponse(Op->command_response);
 			break;
+		}
 
 		// Authority Change
 		case WORKER_OP_TYPE_AUTHORITY_CHANGE:
+		{
+			SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherAuthorityChange);
 			StaticComponentView->OnAuthorityChange(Op->authority_change);
 			Receiver->OnAuthorityChange(Op->authority_change);
 			break;
+		}
 
 		// World Command Responses
 		case WORKER_OP_TYPE_RESERVE_ENTITY_ID_RESPONSE:
+		{
+			SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherWorldCommandResponse);
 			Receiver->OnReserveEntityIdResponse(Op->reserve_entity_id_response);
 			break;
+		}
 		case WORKER_OP_TYPE_RESERVE_ENTITY_IDS_RESPONSE:
+		{
+			SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherWorldCommandResponse);
 			Receiver->OnReserveEntityIdsResponse(Op->reserve_entity_ids_response);
 			break;
+		}
 		case WORKER_OP_TYPE_CREATE_ENTITY_RESPONSE:
+		{
+			SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherWorldCommandResponse);
 			Receiver->OnCreateEntityResponse(Op->create_entity_response);
 			break;
+		}
 		case WORKER_OP_TYPE_DELETE_ENTITY_RESPONSE:
 			break;
 		case WORKER_OP_TYPE_ENTITY_QUERY_RESPONSE:
+		{
+			SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherWorldCommandResponse);
 			Receiver->OnEntityQueryResponse(Op->entity_query_response);
 			break;
+		}
 
 		case WORKER_OP_TYPE_FLAG_UPDATE:
 			USpatialWorkerFlags::ApplyWorkerFlagUpdate(Op->flag_update);
@@ -100,14 +154,14 @@ void USpatialDispatcher::ProcessOps(Worker_OpList* OpList)
 		}
 	}
 
-	for (Worker_Op* Op : QueuedComponentUpdateOps)
-	{
-		Receiver->OnComponentUpdate(Op->component_update);
-	}
+	ProcessQueuedComponentUpdates();
 
 	Receiver->FlushRetryRPCs();
 
+	Receiver->FlushRepNotifies();
+
 	// Check every channel for net ownership changes (determines ACL and component interest)
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherSpatialViewTick);
 	const FActorChannelMap& ChannelMap = NetDriver->GetSpatialOSNetConnection()->ActorChannelMap();
 	for (auto& Pair : ChannelMap)
 	{
@@ -117,3 +171,78 @@ void USpatialDispatcher::ProcessOps(Worker_OpList* OpList)
 		}
 	}
 }
+
+void USpatialDispatcher::ReserveCriticalSection(const Worker_OpList* OpList, size_t FirstOpIndex)
+{
+	// Count the rest of the critical section in this op list, so the receiver can size its staging once instead of growing it
+	// op by op in large critical sections. If the critical section continues in a later op list, the staging grows from there.
+	int32 NumAddEntities = 0;
+	int32 NumAddComponents = 0;
+	int32 NumAuthorityChanges = 0;
+
+	for (size_t i = FirstOpIndex; i < OpList->op_count; ++i)
+	{
+		const Worker_Op& Op = OpList->ops[i];
+		if (Op.op_type == WORKER_OP_TYPE_CRITICAL_SECTION)
+		{
+			break;
+		}
+
+		switch (Op.op_type)
+		{
+		case WORKER_OP_TYPE_ADD_ENTITY:
+			NumAddEntities++;
+			break;
+		case WORKER_OP_TYPE_ADD_COMPONENT:
+			NumAddComponents++;
+			break;
+		case WORKER_OP_TYPE_AUTHORITY_CHANGE:
+			NumAuthorityChanges++;
+			break;
+		default:
+			break;
+		}
+	}
+
+	Receiver->ReserveCriticalSection(NumAddEntities, NumAddComponents, NumAuthorityChanges);
+}
+
+void USpatialDispatcher::QueueComponentUpdate(Worker_ComponentUpdateOp* Op)
+{
+	const int32 Index = QueuedComponentUpdates.Add(FQueuedComponentUpdate{ Op, INDEX_NONE });
+
+	const TPair<Worker_EntityId_Key, Worker_ComponentId> Key(Op->entity_id, Op->update.component_id);
+	if (int32* ListIndex = QueuedComponentUpdateListIndices.Find(Key))
+	{
+		FQueuedComponentUpdateList& List = QueuedComponentUpdateLists[*ListIndex];
+		QueuedComponentUpdates[List.Last].NextIndex = Index;
+		List.Last = Index;
+	}
+	else
+	{
+		QueuedComponentUpdateListIndices.Add(Key, QueuedComponentUpdateLists.Add(FQueuedComponentUpdateList{ Index, Index }));
+	}
+}
+
+void USpatialDispatcher::ProcessQueuedComponentUpdates()
+{
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialDispatcherProcessQueuedComponentUpdates);
+
+	// All the updates an entity component received in this op list are applied together, so properties which were updated
+	// several times are only written, and their RepNotifies called, once with the latest value.
+	for (const FQueuedComponentUpdateList& List : QueuedComponentUpdateLists)
+	{
+		MergedComponentUpdates.Reset();
+		for (int32 Index = List.First; Index != INDEX_NONE; Index = QueuedComponentUpdates[Index].NextIndex)
+		{
+			MergedComponentUpdates.Add(&QueuedComponentUpdates[Index].Op->update);
+		}
+
+		const Worker_ComponentUpdateOp* FirstOp = QueuedComponentUpdates[List.First].Op;
+		Receiver->OnComponentUpdates(FirstOp->entity_id, FirstOp->update.component_id, MergedComponentUpdates);
+	}
+
+	QueuedComponentUpdates.Reset();
+	QueuedComponentUpdateListIndices.Reset();
+	QueuedComponentUpdateLists.Reset();
+}
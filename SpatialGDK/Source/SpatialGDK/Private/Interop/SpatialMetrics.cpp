@@ -0,0 +1,141 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Interop/SpatialMetrics.h"
+
+#include "EngineClasses/SpatialNetDriver.h"
+#include "Interop/Connection/SpatialWorkerConnection.h"
+#include "Interop/SpatialReceiver.h"
+#include "Interop/SpatialSender.h"
+
+#include <WorkerSDK/improbable/c_worker.h>
+
+DEFINE_LOG_CATEGORY(LogSpatialMetrics);
+
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Metrics: Frame Time (ms)"), STAT_SpatialMetricsFrameTime, STATGROUP_SpatialNet);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Metrics: Ops Per Tick"), STAT_SpatialMetricsOpsPerTick, STATGROUP_SpatialNet);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Metrics: ProcessOps (ms)"), STAT_SpatialMetricsProcessOpsTime, STATGROUP_SpatialNet);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Metrics: ServerReplicateActors (ms)"), STAT_SpatialMetricsReplicateActorsTime, STATGROUP_SpatialNet);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Metrics: Actors Replicated Per Tick"), STAT_SpatialMetricsActorsReplicated, STATGROUP_SpatialNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Metrics: Unresolved Refs"), STAT_SpatialMetricsUnresolvedRefs, STATGROUP_SpatialNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Metrics: Pending Reliable RPCs"), STAT_SpatialMetricsPendingReliableRPCs, STATGROUP_SpatialNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Metrics: RPC Retries"), STAT_SpatialMetricsRPCRetries, STATGROUP_SpatialNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Metrics: Queued Outgoing Operations"), STAT_SpatialMetricsQueuedOutgoingOperations, STATGROUP_SpatialNet);
+
+void USpatialMetrics::Init(USpatialNetDriver* InNetDriver)
+{
+	NetDriver = InNetDriver;
+
+	TimeSinceLastReport = 0.f;
+	NumTicks = 0;
+	NumOpsReceived = 0;
+	NumActorsReplicated = 0;
+	LastNumRetriedRPCs = NetDriver->Sender->GetNumRetriedRPCs();
+}
+
+void USpatialMetrics::TickMetrics(float DeltaTime)
+{
+	NumTicks++;
+	FrameTime.AddSample(DeltaTime * 1000.0);
+
+	TimeSinceLastReport += DeltaTime;
+	if (TimeSinceLastReport >= NetDriver->MetricsReportInterval)
+	{
+		ReportMetrics();
+	}
+}
+
+void USpatialMetrics::OnOpsProcessed(uint32 OpCount, double ProcessOpsMs)
+{
+	NumOpsReceived += OpCount;
+	ProcessOpsTime.AddSample(ProcessOpsMs);
+}
+
+void USpatialMetrics::OnServerReplicateActors(int32 ActorsReplicated, double ReplicateActorsMs)
+{
+	NumActorsReplicated += ActorsReplicated;
+	ReplicateActorsTime.AddSample(ReplicateActorsMs);
+}
+
+void USpatialMetrics::ReportMetrics()
+{
+	auto Average = [](double Sum, uint32 Count) { return Count > 0 ? Sum / Count : 0.0; };
+
+	const uint32 NumRetriedRPCs = NetDriver->Sender->GetNumRetriedRPCs();
+
+	const double AverageFrameTimeMs = Average(FrameTime.Sum, FrameTime.NumSamples);
+	const double OpsPerTick = Average(NumOpsReceived, NumTicks);
+	const double AverageProcessOpsMs = Average(ProcessOpsTime.Sum, ProcessOpsTime.NumSamples);
+	const double AverageReplicateActorsMs = Average(ReplicateActorsTime.Sum, ReplicateActorsTime.NumSamples);
+	const double ActorsReplicatedPerTick = Average(NumActorsReplicated, ReplicateActorsTime.NumSamples);
+	const uint32 NumUnresolvedRefs = NetDriver->Receiver->GetNumUnresolvedRefs();
+	const uint32 NumPendingReliableRPCs = NetDriver->Receiver->GetNumPendingReliableRPCs();
+	const uint32 NumRPCRetries = NumRetriedRPCs - LastNumRetriedRPCs;
+	const uint32 NumQueuedOutgoingOperations = NetDriver->Sender->GetNumQueuedOutgoingOperations();
+
+	SET_FLOAT_STAT(STAT_SpatialMetricsFrameTime, AverageFrameTimeMs);
+	SET_FLOAT_STAT(STAT_SpatialMetricsOpsPerTick, OpsPerTick);
+	SET_FLOAT_STAT(STAT_SpatialMetricsProcessOpsTime, AverageProcessOpsMs);
+	SET_FLOAT_STAT(STAT_SpatialMetricsReplicateActorsTime, AverageReplicateActorsMs);
+	SET_FLOAT_STAT(STAT_SpatialMetricsActorsReplicated, ActorsReplicatedPerTick);
+	SET_DWORD_STAT(STAT_SpatialMetricsUnresolvedRefs, NumUnresolvedRefs);
+	SET_DWORD_STAT(STAT_SpatialMetricsPendingReliableRPCs, NumPendingReliableRPCs);
+	SET_DWORD_STAT(STAT_SpatialMetricsRPCRetries, NumRPCRetries);
+	SET_DWORD_STAT(STAT_SpatialMetricsQueuedOutgoingOperations, NumQueuedOutgoingOperations);
+
+	if (NetDriver->Connection != nullptr && NetDriver->Connection->IsConnected())
+	{
+		// The metric keys have to stay valid until SendMetrics returns, so they are all string literals.
+		const Worker_GaugeMetric GaugeMetrics[] =
+		{
+			{ "unreal_gdk_frame_time_ms", AverageFrameTimeMs },
+			{ "unreal_gdk_ops_per_tick", OpsPerTick },
+			{ "unreal_gdk_process_ops_ms", AverageProcessOpsMs },
+			{ "unreal_gdk_server_replicate_actors_ms", AverageReplicateActorsMs },
+			{ "unreal_gdk_actors_replicated_per_tick", ActorsReplicatedPerTick },
+			{ "unreal_gdk_unresolved_refs", static_cast<double>(NumUnresolvedRefs) },
+			{ "unreal_gdk_pending_reliable_rpcs", static_cast<double>(NumPendingReliableRPCs) },
+			{ "unreal_gdk_rpc_retries", static_cast<double>(NumRPCRetries) },
+			{ "unreal_gdk_queued_outgoing_operations", static_cast<double>(NumQueuedOutgoingOperations) }
+		};
+
+		Worker_HistogramMetricBucket Buckets[3][FTimeHistogram::NumBuckets];
+		const FTimeHistogram* Histograms[3] = { &FrameTime, &ProcessOpsTime, &ReplicateActorsTime };
+		for (int32 HistogramIndex = 0; HistogramIndex < 3; HistogramIndex++)
+		{
+			// Worker histogram buckets are cumulative: each counts every sample at or below its upper bound.
+			uint32 CumulativeSamples = 0;
+			for (int32 Bucket = 0; Bucket < FTimeHistogram::NumBuckets; Bucket++)
+			{
+				CumulativeSamples += Histograms[HistogramIndex]->BucketSamples[Bucket];
+				Buckets[HistogramIndex][Bucket].upper_bound = Histograms[HistogramIndex]->GetBucketUpperBound(Bucket);
+				Buckets[HistogramIndex][Bucket].samples = CumulativeSamples;
+			}
+		}
+
+		// Named apart from the gauges, as metrics backends don't accept one name with two metric types.
+		const Worker_HistogramMetric HistogramMetrics[] =
+		{
+			{ "unreal_gdk_frame_time_ms_histogram", FrameTime.Sum, FTimeHistogram::NumBuckets, Buckets[0] },
+			{ "unreal_gdk_process_ops_ms_histogram", ProcessOpsTime.Sum, FTimeHistogram::NumBuckets, Buckets[1] },
+			{ "unreal_gdk_server_replicate_actors_ms_histogram", ReplicateActorsTime.Sum, FTimeHistogram::NumBuckets, Buckets[2] }
+		};
+
+		Worker_Metrics Metrics = {};
+		Metrics.gauge_metric_count = ARRAY_COUNT(GaugeMetrics);
+		Metrics.gauge_metrics = GaugeMetrics;
+		Metrics.histogram_metric_count = ARRAY_COUNT(HistogramMetrics);
+		Metrics.histogram_metrics = HistogramMetrics;
+
+		NetDriver->Connection->SendMetrics(&Metrics);
+	}
+
+	TimeSinceLastReport = 0.f;
+	NumTicks = 0;
+	NumOpsReceived = 0;
+	NumActorsReplicated = 0;
+	LastNumRetriedRPCs = NumRetriedRPCs;
+
+	FrameTime.Reset();
+	ProcessOpsTime.Reset();
+	ReplicateActorsTime.Reset();
+}
@@ -14,30 +14,35 @@
 #include "Interop/SpatialPlayerSpawner.h"
 #include "Interop/SpatialSender.h"
 #include "Schema/DynamicComponent.h"
+#include "Schema/RPCEndpoint.h"
 #include "Schema/SpawnData.h"
 #include "Schema/UnrealMetadata.h"
 #include "SpatialConstants.h"
+#include "Utils/ActorPool.h"
 #include "Utils/ComponentReader.h"
 #include "Utils/EntityRegistry.h"
 #include "Utils/RepLayoutUtils.h"
+#include "Utils/SpatialNetStats.h"
 
 DEFINE_LOG_CATEGORY(LogSpatialReceiver);
 
-using namespace improbable;
+DECLARE_CYCLE_STAT(TEXT("ReceiveActor"), STAT_SpatialReceiverReceiveActor, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("RemoveActor"), STAT_SpatialReceiverRemoveActor, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("ProcessQueuedEntityCheckouts"), STAT_SpatialReceiverProcessQueuedEntityCheckouts, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("HandleActorAuthority"), STAT_SpatialReceiverHandleActorAuthority, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("ApplyComponentData"), STAT_SpatialReceiverApplyComponentData, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("OnComponentUpdates"), STAT_SpatialReceiverOnComponentUpdates, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("ApplyComponentUpdates"), STAT_SpatialReceiverApplyComponentUpdates, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("ReceiveMulticastUpdates"), STAT_SpatialReceiverReceiveMulticastUpdates, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("ReceiveUnreliableRPCUpdate"), STAT_SpatialReceiverReceiveUnreliableRPCUpdate, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("ReceiveRingBufferRPCs"), STAT_SpatialReceiverReceiveRingBufferRPCs, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("ReceiveRPCCommandRequest"), STAT_SpatialReceiverReceiveRPCCommandRequest, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("ApplyRPC"), STAT_SpatialReceiverApplyRPC, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("FlushRepNotifies"), STAT_SpatialReceiverFlushRepNotifies, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("ProcessQueuedResolvedObjects"), STAT_SpatialReceiverProcessQueuedResolvedObjects, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("ResolveObjectReferences"), STAT_SpatialReceiverResolveObjectReferences, STATGROUP_SpatialNet);
 
-template <typename T>
-T* GetComponentData(USpatialReceiver& Receiver, Worker_EntityId EntityId)
-{
-	for (PendingAddComponentWrapper& PendingAddComponent : Receiver.PendingAddComponents)
-	{
-		if (PendingAddComponent.EntityId == EntityId && PendingAddComponent.ComponentId == T::ComponentId)
-		{
-			return static_cast<T*>(PendingAddComponent.Data.Get());
-		}
-	}
-
-	return nullptr;
-}
+using namespace improbable;
 
 void USpatialReceiver::Init(USpatialNetDriver* InNetDriver, FTimerManager* InTimerManager)
 {
@@ -62,6 +67,14 @@ void USpatialReceiver::OnCriticalSection(bool InCriticalSection)
 	}
 }
 
+void USpatialReceiver::ReserveCriticalSection(int32 NumAddEntities, int32 NumAddComponents, int32 NumAuthorityChanges)
+{
+	PendingAddEntities.Reserve(NumAddEntities);
+	PendingAddComponents.Reserve(NumAddComponents);
+	EntityPendingAddComponents.Reserve(NumAddEntities);
+	PendingAuthorityChanges.Reserve(NumAuthorityChanges);
+}
+
 void USpatialReceiver::EnterCriticalSection()
 {
 	UE_LOG(LogSpatialReceiver, Verbose, TEXT("Entering critical section."));
@@ -76,11 +89,24 @@ void USpatialReceiver::LeaveCriticalSection()
 
 	for (Worker_EntityId& PendingAddEntity : PendingAddEntities)
 	{
-		ReceiveActor(PendingAddEntity);
+		if (ShouldQueueEntityCheckout(PendingAddEntity))
+		{
+			QueueEntityCheckout(PendingAddEntity);
+		}
+		else
+		{
+			ReceiveActor(PendingAddEntity);
+		}
 	}
 
 	for (Worker_AuthorityChangeOp& PendingAuthorityChange : PendingAuthorityChanges)
 	{
+		if (FQueuedEntityCheckout* QueuedCheckout = QueuedEntityCheckouts.Find(PendingAuthorityChange.entity_id))
+		{
+			QueuedCheckout->AuthorityChanges.Add(PendingAuthorityChange);
+			continue;
+		}
+
 		HandleActorAuthority(PendingAuthorityChange);
 	}
 
@@ -89,12 +115,18 @@ void USpatialReceiver::LeaveCriticalSection()
 		RemoveActor(PendingRemoveEntity);
 	}
 
+	for (PendingAddComponentWrapper& PendingAddComponent : PendingAddComponents)
+	{
+		Worker_ReleaseComponentData(PendingAddComponent.Data);
+	}
+
 	// Mark that we've left the critical section.
 	bInCriticalSection = false;
-	PendingAddEntities.Empty();
-	PendingAddComponents.Empty();
-	PendingAuthorityChanges.Empty();
-	PendingRemoveEntities.Empty();
+	PendingAddEntities.Reset();
+	PendingAddComponents.Reset();
+	EntityPendingAddComponents.Reset();
+	PendingAuthorityChanges.Reset();
+	PendingRemoveEntities.Reset();
 
 	ProcessQueuedResolvedObjects();
 }
@@ -113,15 +145,33 @@ void USpatialReceiver::OnAddComponent(Worker_AddComponentOp& Op)
 	UE_LOG(LogSpatialReceiver, Verbose, TEXT("AddComponent component ID: %u entity ID: %lld"),
 		Op.data.component_id, Op.entity_id);
 
+	if (Op.data.component_id == SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID || Op.data.component_id == SpatialConstants::SERVER_RPC_ENDPOINT_COMPONENT_ID)
+	{
+		// The view already has the endpoint. Outside a critical section it was brought into interest by this client gaining ownership,
+		// and it can already hold RPCs for us. Within one, authority over the other endpoint hasn't been received yet, and the RPCs are
+		// handled when it is.
+		if (!bInCriticalSection)
+		{
+			ReceiveRingBufferRPCs(Op.entity_id, Op.data.component_id);
+		}
+		return;
+	}
+
 	if (!bInCriticalSection)
 	{
+		// RPC components come and go with the interest overrides of ownership and multicast culling (see
+		// USpatialNetDriver::MulticastRelevancyUpdateInterval). They have no data, so there is nothing to apply.
+		const ESchemaComponentType Category = ClassInfoManager->GetCategoryByComponentId(Op.data.component_id);
+		if (Category == SCHEMA_ClientRPC || Category == SCHEMA_ServerRPC || Category == SCHEMA_NetMulticastRPC)
+		{
+			return;
+		}
+
 		UE_LOG(LogSpatialReceiver, Warning, TEXT("Received a dynamically added component, these are currently unsupported - component ID: %u entity ID: %lld"),
 			Op.data.component_id, Op.entity_id);
 		return;
 	}
 
-	TSharedPtr<improbable::Component> Data;
-
 	switch (Op.data.component_id)
 	{
 	case SpatialConstants::ENTITY_ACL_COMPONENT_ID:
@@ -143,16 +193,28 @@ void USpatialReceiver::OnAddComponent(Worker_AddComponentOp& Op)
  		GlobalStateManager->ApplyDeploymentMapURLData(Op.data);
 		return;
 	default:
-		Data = MakeShared<improbable::DynamicComponent>(Op.data);
 		break;
 	}
 
-	PendingAddComponents.Emplace(Op.entity_id, Op.data.component_id, Data);
+	const int32 Index = PendingAddComponents.Emplace(Op.entity_id, Op.data.component_id, Worker_AcquireComponentData(&Op.data));
+
+	if (FPendingAddComponentList* PendingList = EntityPendingAddComponents.Find(Op.entity_id))
+	{
+		PendingAddComponents[PendingList->Last].NextIndex = Index;
+		PendingList->Last = Index;
+	}
+	else
+	{
+		EntityPendingAddComponents.Add(Op.entity_id, FPendingAddComponentList{ Index, Index });
+	}
 }
 
 void USpatialReceiver::OnRemoveEntity(Worker_RemoveEntityOp& Op)
 {
 	RemoveActor(Op.entity_id);
+
+	LastReceivedRingBufferRPCIds.Remove(Op.entity_id);
+	Sender->RemoveRPCRingBuffer(Op.entity_id);
 }
 
 void USpatialReceiver::UpdateShadowData(Worker_EntityId EntityId)
@@ -169,12 +231,35 @@ void USpatialReceiver::OnAuthorityChange(Worker_AuthorityChangeOp& Op)
 		return;
 	}
 
+	if (FQueuedEntityCheckout* QueuedCheckout = QueuedEntityCheckouts.Find(Op.entity_id))
+	{
+		QueuedCheckout->AuthorityChanges.Add(Op);
+		return;
+	}
+
 	HandleActorAuthority(Op);
 }
 
 // TODO UNR-640 - This function needs a pass once we introduce soft handover (AUTHORITY_LOSS_IMMINENT)
 void USpatialReceiver::HandleActorAuthority(Worker_AuthorityChangeOp& Op)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialReceiverHandleActorAuthority);
+
+	if (Op.component_id == SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID || Op.component_id == SpatialConstants::SERVER_RPC_ENDPOINT_COMPONENT_ID)
+	{
+		if (Op.authority == WORKER_AUTHORITY_AUTHORITATIVE)
+		{
+			// Handle the RPCs the other endpoint sent before we could acknowledge them.
+			ReceiveRingBufferRPCs(Op.entity_id, GetOtherRPCEndpointComponentId(Op.component_id));
+		}
+		else if (Op.authority == WORKER_AUTHORITY_NOT_AUTHORITATIVE)
+		{
+			LastReceivedRingBufferRPCIds.Remove(Op.entity_id);
+			Sender->OnRPCEndpointAuthorityLost(Op.entity_id);
+		}
+		return;
+	}
+
 	if (NetDriver->IsServer())
 	{
 		if (Op.component_id == SpatialConstants::DEPLOYMENT_MAP_COMPONENT_ID)
@@ -194,6 +279,11 @@ void USpatialReceiver::HandleActorAuthority(Worker_AuthorityChangeOp& Op)
 		{
 			Sender->ProcessUpdatesQueuedUntilAuthority(Op.entity_id);
 		}
+		else if (ClassInfoManager->GetCategoryByComponentId(Op.component_id) == SCHEMA_NetMulticastRPC)
+		{
+			// Send the batched multicasts of the entity while we can, or drop them if authority is already gone.
+			Sender->FlushMulticastRPCs(Op.entity_id);
+		}
 
 		// If we became authoritative over the position component. set our role to be ROLE_Authority
 		// and set our RemoteRole to be ROLE_AutonomousProxy if the actor has an owning connection.
@@ -220,6 +310,15 @@ void USpatialReceiver::HandleActorAuthority(Worker_AuthorityChangeOp& Op)
 				}
 				else if (Op.authority == WORKER_AUTHORITY_AUTHORITY_LOSS_IMMINENT)
 				{
+					// Flush handover properties which haven't been sent yet, so the worker gaining authority gets their latest values.
+					if (USpatialActorChannel* Channel = NetDriver->GetActorChannelByEntityId(Op.entity_id))
+					{
+						Channel->ReplicateHandover();
+					}
+
+					// Batched multicasts can only be sent while this worker is still authoritative.
+					Sender->FlushMulticastRPCs(Op.entity_id);
+
 					Actor->OnAuthorityLossImminent();
 				}
 				else if (Op.authority == WORKER_AUTHORITY_NOT_AUTHORITATIVE)
@@ -248,7 +347,7 @@ void USpatialReceiver::HandleActorAuthority(Worker_AuthorityChangeOp& Op)
 	}
 
 #if !UE_BUILD_SHIPPING
-	if (AActor* Actor = NetDriver->GetEntityRegistry()->GetActorFromEntityId(Op.entity_id))
+	if (USpatialActorChannel* Channel = NetDriver->GetActorChannelByEntityId(Op.entity_id))
 	{
 		if (Op.authority == WORKER_AUTHORITY_AUTHORITATIVE)
 		{
@@ -257,15 +356,17 @@ void USpatialReceiver::HandleActorAuthority(Worker_AuthorityChangeOp& Op)
 			{
 				// This could be either an RPC component on the actor or the subobject, but we assume
 				// they will be received together, so resetting multiple times should not be a problem.
-				NetDriver->OnRPCAuthorityGained(Actor, ComponentType);
+				Channel->OnRPCAuthorityGained(ComponentType);
 			}
 		}
 	}
 #endif // !UE_BUILD_SHIPPING
 }
 
-void USpatialReceiver::ReceiveActor(Worker_EntityId EntityId)
+void USpatialReceiver::ReceiveActor(Worker_EntityId EntityId, const FQueuedEntityCheckout* QueuedCheckout)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialReceiverReceiveActor);
+
 	checkf(NetDriver, TEXT("We should have a NetDriver whilst processing ops."));
 	checkf(NetDriver->GetWorld(), TEXT("We should have a World whilst processing ops."));
 
@@ -304,7 +405,7 @@ void USpatialReceiver::ReceiveActor(Worker_EntityId EntityId)
 	}
 	else
 	{
-		UClass* ActorClass = UnrealMetadata->GetNativeEntityClass();
+		UClass* ActorClass = UnrealMetadata->GetNativeEntityClass(ClassInfoManager);
 
 		if (ActorClass == nullptr)
 		{
@@ -323,6 +424,7 @@ void USpatialReceiver::ReceiveActor(Worker_EntityId EntityId)
 		improbable::UnrealMetadata* UnrealMetadataComponent = StaticComponentView->GetComponentData<improbable::UnrealMetadata>(EntityId);
 		check(UnrealMetadataComponent);
 		bool bDoingDeferredSpawn = false;
+		bool bReusingPooledActor = false;
 
 		// If we're checking out a player controller, spawn it via "USpatialNetDriver::AcceptNewPlayer"
 		if (NetDriver->IsServer() && ActorClass->IsChildOf(APlayerController::StaticClass()))
@@ -340,16 +442,29 @@ void USpatialReceiver::ReceiveActor(Worker_EntityId EntityId)
 		}
 		else
 		{
-			UE_LOG(LogSpatialReceiver, Verbose, TEXT("Spawning a %s whilst checking out an entity."), *ActorClass->GetFullName());
+			if (!NetDriver->IsServer() && NetDriver->ActorPool->IsPooledClass(ActorClass))
+			{
+				FVector SpawnLocation = FRepMovement::RebaseOntoLocalOrigin(SpawnData->Location, NetDriver->GetWorld()->OriginLocation);
+				EntityActor = NetDriver->ActorPool->AcquireActor(ActorClass, FTransform(SpawnData->Rotation, SpawnLocation, SpawnData->Scale));
+				bReusingPooledActor = EntityActor != nullptr;
+			}
+
+			if (bReusingPooledActor)
+			{
+				UE_LOG(LogSpatialReceiver, Verbose, TEXT("Reusing a pooled %s whilst checking out an entity."), *ActorClass->GetFullName());
+			}
+			else
+			{
+				UE_LOG(LogSpatialReceiver, Verbose, TEXT("Spawning a %s whilst checking out an entity."), *ActorClass->GetFullName());
 
-			EntityActor = CreateActor(SpawnData, ActorClass, true);
+				EntityActor = CreateActor(SpawnData, ActorClass, true);
+				bDoingDeferredSpawn = true;
+			}
 
 			// Don't have authority over Actor until SpatialOS delegates authority
 			EntityActor->Role = ROLE_SimulatedProxy;
 			EntityActor->RemoteRole = ROLE_Authority;
 
-			bDoingDeferredSpawn = true;
-
 			// Get the net connection for this actor.
 			if (NetDriver->IsServer())
 			{
@@ -396,6 +511,11 @@ void USpatialReceiver::ReceiveActor(Worker_EntityId EntityId)
 				EntityActor->SetActorScale3D(SpawnData->Scale);
 			}
 		}
+		else if (bReusingPooledActor)
+		{
+			// The pool already placed the actor, but it may still be moving with the velocity of the entity it was used for before.
+			EntityActor->PostNetReceiveVelocity(SpawnData->Velocity);
+		}
 
 		PackageMap->ResolveEntityActor(EntityActor, EntityId);
 
@@ -404,11 +524,18 @@ void USpatialReceiver::ReceiveActor(Worker_EntityId EntityId)
 		// Apply initial replicated properties.
 		// This was moved to after FinishingSpawning because components existing only in blueprints aren't added until spawning is complete
 		// Potentially we could split out the initial actor state and the initial component state
-		for (PendingAddComponentWrapper& PendingAddComponent : PendingAddComponents)
+		if (QueuedCheckout != nullptr)
+		{
+			for (const TSharedPtr<improbable::DynamicComponent>& Component : QueuedCheckout->Components)
+			{
+				ApplyComponentData(EntityId, *Component->Data, Channel);
+			}
+		}
+		else if (const FPendingAddComponentList* PendingList = EntityPendingAddComponents.Find(EntityId))
 		{
-			if (PendingAddComponent.EntityId == EntityId && PendingAddComponent.Data.IsValid() && PendingAddComponent.Data->bIsDynamic)
+			for (int32 Index = PendingList->First; Index != INDEX_NONE; Index = PendingAddComponents[Index].NextIndex)
 			{
-				ApplyComponentData(EntityId, *static_cast<improbable::DynamicComponent*>(PendingAddComponent.Data.Get())->Data, Channel);
+				ApplyComponentData(EntityId, *PendingAddComponents[Index].Data, Channel);
 			}
 		}
 
@@ -434,6 +561,9 @@ void USpatialReceiver::ReceiveActor(Worker_EntityId EntityId)
 
 		}
 
+		// Initial RepNotifies are called before BeginPlay, as in native Unreal.
+		Channel->FlushRepNotifies();
+
 		// Taken from PostNetInit
 		if (!EntityActor->HasActorBegunPlay())
 		{
@@ -444,8 +574,164 @@ void USpatialReceiver::ReceiveActor(Worker_EntityId EntityId)
 	}
 }
 
+bool USpatialReceiver::ShouldQueueEntityCheckout(Worker_EntityId EntityId) const
+{
+	if (NetDriver->EntityCheckoutBudgetMs <= 0.0f)
+	{
+		return false;
+	}
+
+	// Only entities which will spawn a new actor are worth spreading out. Actors which already exist on this worker are just linked up.
+	return StaticComponentView->GetComponentData<improbable::UnrealMetadata>(EntityId) != nullptr
+		&& NetDriver->GetEntityRegistry()->GetActorFromEntityId(EntityId) == nullptr;
+}
+
+void USpatialReceiver::QueueEntityCheckout(Worker_EntityId EntityId)
+{
+	FQueuedEntityCheckout& QueuedCheckout = QueuedEntityCheckouts.Add(EntityId);
+	QueuedCheckout.EntityId = EntityId;
+
+	// The pending components are cleared when leaving the critical section, so keep hold of the entity's data until it's spawned.
+	if (const FPendingAddComponentList* PendingList = EntityPendingAddComponents.Find(EntityId))
+	{
+		for (int32 Index = PendingList->First; Index != INDEX_NONE; Index = PendingAddComponents[Index].NextIndex)
+		{
+			QueuedCheckout.Components.Add(MakeShared<improbable::DynamicComponent>(*PendingAddComponents[Index].Data));
+		}
+	}
+
+	UE_LOG(LogSpatialReceiver, Verbose, TEXT("Queued checkout of entity %lld."), EntityId);
+}
+
+void USpatialReceiver::CheckoutQueuedEntity(Worker_EntityId EntityId)
+{
+	FQueuedEntityCheckout QueuedCheckout;
+	if (!QueuedEntityCheckouts.RemoveAndCopyValue(EntityId, QueuedCheckout))
+	{
+		return;
+	}
+
+	ReceiveActor(EntityId, &QueuedCheckout);
+
+	for (Worker_AuthorityChangeOp& AuthorityChange : QueuedCheckout.AuthorityChanges)
+	{
+		HandleActorAuthority(AuthorityChange);
+	}
+
+	// Replay the updates received while the entity was queued, in the order they arrived.
+	for (Worker_ComponentUpdate* ComponentUpdate : QueuedCheckout.ComponentUpdates)
+	{
+		Worker_ComponentUpdateOp Op = {};
+		Op.entity_id = EntityId;
+		Op.update = *ComponentUpdate;
+		OnComponentUpdate(Op);
+
+		Worker_ReleaseComponentUpdate(ComponentUpdate);
+	}
+}
+
+void USpatialReceiver::DropQueuedEntityCheckout(Worker_EntityId EntityId)
+{
+	FQueuedEntityCheckout QueuedCheckout;
+	if (!QueuedEntityCheckouts.RemoveAndCopyValue(EntityId, QueuedCheckout))
+	{
+		return;
+	}
+
+	for (Worker_ComponentUpdate* ComponentUpdate : QueuedCheckout.ComponentUpdates)
+	{
+		Worker_ReleaseComponentUpdate(ComponentUpdate);
+	}
+
+	UE_LOG(LogSpatialReceiver, Verbose, TEXT("Entity %lld was removed before its queued checkout was processed."), EntityId);
+}
+
+void USpatialReceiver::ProcessQueuedEntityCheckouts()
+{
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialReceiverProcessQueuedEntityCheckouts);
+
+	if (QueuedEntityCheckouts.Num() == 0)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Spawn the entities closest to what the local players are looking at first.
+	TArray<FVector> ViewLocations;
+	if (UWorld* World = NetDriver->GetWorld())
+	{
+		for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+		{
+			APlayerController* PlayerController = Iterator->Get();
+			if (PlayerController != nullptr && PlayerController->IsLocalController())
+			{
+				FVector ViewLocation;
+				FRotator ViewRotation;
+				PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+				ViewLocations.Add(ViewLocation);
+			}
+		}
+	}
+
+	TArray<TPair<float, Worker_EntityId>> PrioritizedEntities;
+	PrioritizedEntities.Reserve(QueuedEntityCheckouts.Num());
+
+	for (const TPair<Worker_EntityId_Key, FQueuedEntityCheckout>& QueuedCheckout : QueuedEntityCheckouts)
+	{
+		float DistanceSquared = 0.0f;
+
+		improbable::Position* Position = StaticComponentView->GetComponentData<improbable::Position>(QueuedCheckout.Key);
+		if (Position != nullptr && ViewLocations.Num() > 0)
+		{
+			const FVector EntityLocation = improbable::Coordinates::ToFVector(Position->Coords);
+
+			DistanceSquared = MAX_flt;
+			for (const FVector& ViewLocation : ViewLocations)
+			{
+				DistanceSquared = FMath::Min(DistanceSquared, FVector::DistSquared(EntityLocation, ViewLocation));
+			}
+		}
+
+		PrioritizedEntities.Emplace(DistanceSquared, QueuedCheckout.Key);
+	}
+
+	PrioritizedEntities.Sort([](const TPair<float, Worker_EntityId>& A, const TPair<float, Worker_EntityId>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	// If the budget has been turned off, drain the queue. Otherwise always make progress by spawning at least one entity per frame.
+	const float BudgetMs = NetDriver->EntityCheckoutBudgetMs;
+	const double EndTime = StartTime + BudgetMs / 1000.0;
+
+	for (const TPair<float, Worker_EntityId>& Entity : PrioritizedEntities)
+	{
+		CheckoutQueuedEntity(Entity.Value);
+
+		if (BudgetMs > 0.0f && FPlatformTime::Seconds() >= EndTime)
+		{
+			break;
+		}
+	}
+
+	FlushRepNotifies();
+
+	UE_LOG(LogSpatialReceiver, Verbose, TEXT("Processed queued entity checkouts in %.2f ms, %d entities left in the queue."),
+		(FPlatformTime::Seconds() - StartTime) * 1000.0, QueuedEntityCheckouts.Num());
+}
+
 void USpatialReceiver::RemoveActor(Worker_EntityId EntityId)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialReceiverRemoveActor);
+
+	if (QueuedEntityCheckouts.Contains(EntityId))
+	{
+		// The actor was never spawned, so there is nothing to clean up.
+		DropQueuedEntityCheckout(EntityId);
+		return;
+	}
+
 	AActor* Actor = NetDriver->GetEntityRegistry()->GetActorFromEntityId(EntityId);
 
 	UE_LOG(LogSpatialReceiver, Log, TEXT("Worker %s Remove Actor: %s %lld"), *NetDriver->Connection->GetWorkerId(), Actor ? *Actor->GetName() : TEXT("nullptr"), EntityId);
@@ -497,6 +783,11 @@ void USpatialReceiver::RemoveActor(Worker_EntityId EntityId)
 		return;
 	}
 
+	if (TryPoolActor(Actor, EntityId))
+	{
+		return;
+	}
+
 	// Destruction of actors can cause the destruction of associated actors (eg. Character > Controller). Actor destroy
 	// calls will eventually find their way into USpatialActorChannel::DeleteEntityIfAuthoritative() which checks if the entity
 	// is currently owned by this worker before issuing an entity delete request. If the associated entity is still authoritative
@@ -530,6 +821,39 @@ void USpatialReceiver::RemoveActor(Worker_EntityId EntityId)
 	CleanupDeletedEntity(EntityId);
 }
 
+bool USpatialReceiver::TryPoolActor(AActor* Actor, Worker_EntityId EntityId)
+{
+	// Servers don't pool, as actors can be removed from them while other actors they're associated with are migrating.
+	if (NetDriver->IsServer() || !NetDriver->ActorPool->IsPooledClass(Actor->GetClass()))
+	{
+		return false;
+	}
+
+	// Let the normal removal destroy the actor if there's no room for it, rather than detaching it from its channel first.
+	if (!NetDriver->ActorPool->HasCapacity(Actor->GetClass()))
+	{
+		return false;
+	}
+
+	USpatialActorChannel* ActorChannel = NetDriver->GetActorChannelByEntityId(EntityId);
+	if (ActorChannel == nullptr)
+	{
+		return false;
+	}
+
+	// Close the channel without destroying the actor, and unbind the actor from the entity before it can be reused.
+	ActorChannel->DetachActorForPooling();
+	ActorChannel->ConditionalCleanUp();
+	CleanupDeletedEntity(EntityId);
+
+	if (!NetDriver->ActorPool->ReleaseActor(Actor))
+	{
+		Actor->Destroy(true);
+	}
+
+	return true;
+}
+
 void USpatialReceiver::CleanupDeletedEntity(Worker_EntityId EntityId)
 {
 	Cast<USpatialPackageMapClient>(NetDriver->GetSpatialOSNetConnection()->PackageMap)->RemoveEntityActor(EntityId);
@@ -577,6 +901,8 @@ FTransform USpatialReceiver::GetRelativeSpawnTransform(UClass* ActorClass, FTran
 
 void USpatialReceiver::ApplyComponentData(Worker_EntityId EntityId, Worker_ComponentData& Data, USpatialActorChannel* Channel)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialReceiverApplyComponentData);
+
 	uint32 Offset = 0;
 	bool bFoundOffset = ClassInfoManager->GetOffsetByComponentId(Data.component_id, Offset);
 	if (!bFoundOffset)
@@ -637,13 +963,22 @@ void USpatialReceiver::ApplyComponentData(Worker_EntityId EntityId, Worker_Compo
 
 void USpatialReceiver::OnComponentUpdate(Worker_ComponentUpdateOp& Op)
 {
-	if (StaticComponentView->GetAuthority(Op.entity_id, Op.update.component_id) == WORKER_AUTHORITY_AUTHORITATIVE)
+	TArray<const Worker_ComponentUpdate*> Updates;
+	Updates.Add(&Op.update);
+	OnComponentUpdates(Op.entity_id, Op.update.component_id, Updates);
+}
+
+void USpatialReceiver::OnComponentUpdates(Worker_EntityId EntityId, Worker_ComponentId ComponentId, const TArray<const Worker_ComponentUpdate*>& Updates)
+{
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialReceiverOnComponentUpdates);
+
+	if (StaticComponentView->GetAuthority(EntityId, ComponentId) == WORKER_AUTHORITY_AUTHORITATIVE)
 	{
-		UE_LOG(LogSpatialReceiver, Verbose, TEXT("Entity: %d Component: %d - Skipping update because this was short circuited"), Op.entity_id, Op.update.component_id);
+		UE_LOG(LogSpatialReceiver, Verbose, TEXT("Entity: %d Component: %d - Skipping update because this was short circuited"), EntityId, ComponentId);
 		return;
 	}
 
-	switch (Op.update.component_id)
+	switch (ComponentId)
 	{
 	case SpatialConstants::ENTITY_ACL_COMPONENT_ID:
 	case SpatialConstants::METADATA_COMPONENT_ID:
@@ -654,31 +989,62 @@ void USpatialReceiver::OnComponentUpdate(Worker_ComponentUpdateOp& Op)
 	case SpatialConstants::PLAYER_SPAWNER_COMPONENT_ID:
 	case SpatialConstants::SINGLETON_COMPONENT_ID:
 	case SpatialConstants::UNREAL_METADATA_COMPONENT_ID:
-		UE_LOG(LogSpatialReceiver, Verbose, TEXT("Entity: %d Component: %d - Skipping because this is hand-written Spatial component"), Op.entity_id, Op.update.component_id);
+		UE_LOG(LogSpatialReceiver, Verbose, TEXT("Entity: %d Component: %d - Skipping because this is hand-written Spatial component"), EntityId, ComponentId);
 		return;
 	case SpatialConstants::SINGLETON_MANAGER_COMPONENT_ID:
-		GlobalStateManager->ApplyUpdate(Op.update);
+		for (const Worker_ComponentUpdate* Update : Updates)
+		{
+			GlobalStateManager->ApplyUpdate(*Update);
+		}
 		GlobalStateManager->LinkAllExistingSingletonActors();
 		return;
 	case SpatialConstants::DEPLOYMENT_MAP_COMPONENT_ID:
-		NetDriver->GlobalStateManager->ApplyDeploymentMapUpdate(Op.update);
+		for (const Worker_ComponentUpdate* Update : Updates)
+		{
+			NetDriver->GlobalStateManager->ApplyDeploymentMapUpdate(*Update);
+		}
+		return;
+	case SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID:
+	case SpatialConstants::SERVER_RPC_ENDPOINT_COMPONENT_ID:
+		if (AreDetailedNetStatsEnabled())
+		{
+			for (const Worker_ComponentUpdate* Update : Updates)
+			{
+				RecordComponentUpdateBytes(ComponentId == SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID ? SCHEMA_ServerRPC : SCHEMA_ClientRPC, /* bSent */ false, *Update);
+			}
+		}
+
+		// The view already has the latest state of the endpoint, so the updates themselves aren't needed. They can carry new
+		// RPCs for this worker, and acknowledgements of the RPCs this worker sent.
+		ReceiveRingBufferRPCs(EntityId, ComponentId);
+		Sender->FlushOverflowedRingBufferRPCs(EntityId);
+		return;
+	}
+
+	if (FQueuedEntityCheckout* QueuedCheckout = QueuedEntityCheckouts.Find(EntityId))
+	{
+		// Hold on to the updates until the actor is spawned, so no property or multicast changes are lost.
+		for (const Worker_ComponentUpdate* Update : Updates)
+		{
+			QueuedCheckout->ComponentUpdates.Add(Worker_AcquireComponentUpdate(Update));
+		}
 		return;
 	}
 
-	USpatialActorChannel* Channel = NetDriver->GetActorChannelByEntityId(Op.entity_id);
+	USpatialActorChannel* Channel = NetDriver->GetActorChannelByEntityId(EntityId);
 	if (Channel == nullptr)
 	{
-		UE_LOG(LogSpatialReceiver, Verbose, TEXT("Worker: %s Entity: %d Component: %d - No actor channel for update. This most likely occured due to the component updates that are sent when authority is lost during entity deletion."), *NetDriver->Connection->GetWorkerId(), Op.entity_id, Op.update.component_id);
+		UE_LOG(LogSpatialReceiver, Verbose, TEXT("Worker: %s Entity: %d Component: %d - No actor channel for update. This most likely occured due to the component updates that are sent when authority is lost during entity deletion."), *NetDriver->Connection->GetWorkerId(), EntityId, ComponentId);
 		return;
 	}
 
-	const FClassInfo& Info = ClassInfoManager->GetClassInfoByComponentId(Op.update.component_id);
+	const FClassInfo& Info = ClassInfoManager->GetClassInfoByComponentId(ComponentId);
 
 	uint32 Offset;
-	bool bFoundOffset = ClassInfoManager->GetOffsetByComponentId(Op.update.component_id, Offset);
+	bool bFoundOffset = ClassInfoManager->GetOffsetByComponentId(ComponentId, Offset);
 	if (!bFoundOffset)
 	{
-		UE_LOG(LogSpatialReceiver, Warning, TEXT("Entity: %d Component: %d - Couldn't find Offset for component id"), Op.entity_id, Op.update.component_id);
+		UE_LOG(LogSpatialReceiver, Warning, TEXT("Entity: %d Component: %d - Couldn't find Offset for component id"), EntityId, ComponentId);
 		return;
 	}
 
@@ -695,36 +1061,61 @@ void USpatialReceiver::OnComponentUpdate(Worker_ComponentUpdateOp& Op)
 
 	if (TargetObject == nullptr)
 	{
-		UE_LOG(LogSpatialReceiver, Warning, TEXT("Entity: %d Component: %d - Couldn't find target object for update"), Op.entity_id, Op.update.component_id);
+		UE_LOG(LogSpatialReceiver, Warning, TEXT("Entity: %d Component: %d - Couldn't find target object for update"), EntityId, ComponentId);
 		return;
 	}
 
-	ESchemaComponentType Category = ClassInfoManager->GetCategoryByComponentId(Op.update.component_id);
+	ESchemaComponentType Category = ClassInfoManager->GetCategoryByComponentId(ComponentId);
+
+	if (AreDetailedNetStatsEnabled())
+	{
+		for (const Worker_ComponentUpdate* Update : Updates)
+		{
+			RecordComponentUpdateBytes(Category, /* bSent */ false, *Update);
+		}
+	}
 
 	if (Category == ESchemaComponentType::SCHEMA_Data || Category == ESchemaComponentType::SCHEMA_OwnerOnly)
 	{
-		ApplyComponentUpdate(Op.update, TargetObject, Channel, /* bIsHandover */ false);
+		ApplyComponentUpdates(Updates, TargetObject, Channel, /* bIsHandover */ false);
 	}
 	else if (Category == ESchemaComponentType::SCHEMA_Handover)
 	{
 		if (!NetDriver->IsServer())
 		{
-			UE_LOG(LogSpatialReceiver, Verbose, TEXT("Entity: %d Component: %d - Skipping Handover component because we're a client."), Op.entity_id, Op.update.component_id);
+			UE_LOG(LogSpatialReceiver, Verbose, TEXT("Entity: %d Component: %d - Skipping Handover component because we're a client."), EntityId, ComponentId);
 			return;
 		}
 
-		ApplyComponentUpdate(Op.update, TargetObject, Channel, /* bIsHandover */ true);
+		ApplyComponentUpdates(Updates, TargetObject, Channel, /* bIsHandover */ true);
 	}
 	else if (Category == ESchemaComponentType::SCHEMA_NetMulticastRPC)
 	{
 		if (const TArray<UFunction*>* RPCArray = Info.RPCs.Find(SCHEMA_NetMulticastRPC))
 		{
-			ReceiveMulticastUpdate(Op.update, TargetObject, *RPCArray);
+			// Events aren't merged, every multicast RPC is called in the order it was sent.
+			ReceiveMulticastUpdates(Updates, TargetObject, *RPCArray);
+		}
+	}
+	else if (Category == ESchemaComponentType::SCHEMA_ClientRPC || Category == ESchemaComponentType::SCHEMA_ServerRPC)
+	{
+		// Unreliable RPC events are sent on the RPC component of the other type, see USpatialSender::SendUnreliableRPCEvent.
+		// Like commands, they are only handled by the worker authoritative over the component of their own type.
+		const ESchemaComponentType RPCType = Category == SCHEMA_ClientRPC ? SCHEMA_ServerRPC : SCHEMA_ClientRPC;
+		if (StaticComponentView->HasAuthority(EntityId, Info.SchemaComponents[RPCType]))
+		{
+			if (const TArray<UFunction*>* RPCArray = Info.RPCs.Find(RPCType))
+			{
+				for (const Worker_ComponentUpdate* Update : Updates)
+				{
+					ReceiveUnreliableRPCUpdate(*Update, Channel, TargetObject, *RPCArray);
+				}
+			}
 		}
 	}
 	else
 	{
-		UE_LOG(LogSpatialReceiver, Verbose, TEXT("Entity: %d Component: %d - Skipping because it's an empty component update from an RPC component. (most likely as a result of gaining authority)"), Op.entity_id, Op.update.component_id);
+		UE_LOG(LogSpatialReceiver, Verbose, TEXT("Entity: %d Component: %d - Skipping because it's an empty component update from an RPC component. (most likely as a result of gaining authority)"), EntityId, ComponentId);
 	}
 }
 
@@ -749,6 +1140,9 @@ void USpatialReceiver::OnCommandRequest(Worker_CommandRequestOp& Op)
 	Response.component_id = Op.request.component_id;
 	Response.schema_type = Schema_CreateCommandResponse(Op.request.component_id, CommandIndex);
 
+	// An RPC can't wait for the checkout budget, so spawn its target right away.
+	CheckoutQueuedEntity(Op.entity_id);
+
 	uint32 Offset = 0;
 	bool bFoundOffset = ClassInfoManager->GetOffsetByComponentId(Op.request.component_id, Offset);
 	if (!bFoundOffset)
@@ -771,13 +1165,23 @@ void USpatialReceiver::OnCommandRequest(Worker_CommandRequestOp& Op)
 	ESchemaComponentType RPCType = ClassInfoManager->GetCategoryByComponentId(Op.request.component_id);
 	check(RPCType >= SCHEMA_FirstRPC && RPCType <= SCHEMA_LastRPC);
 
+	if (AreDetailedNetStatsEnabled())
+	{
+		RecordCommandRequestBytes(RPCType, /* bSent */ false, Op.request);
+	}
+
 	const TArray<UFunction*>* RPCArray = Info.RPCs.Find(RPCType);
 	check(RPCArray);
 	check((int)CommandIndex - 1 < RPCArray->Num());
 
 	UFunction* Function = (*RPCArray)[CommandIndex - 1];
 
-	ReceiveRPCCommandRequest(Op.request, TargetObject, Function, UTF8_TO_TCHAR(Op.caller_worker_id));
+	FName SenderWorkerId;
+#if !UE_BUILD_SHIPPING
+	SenderWorkerId = FName(Op.caller_worker_id);
+#endif // !UE_BUILD_SHIPPING
+
+	ReceiveRPCCommandRequest(Op.request, TargetObject, Function, SenderWorkerId);
 
 	Sender->SendCommandResponse(Op.request_id, Response);
 }
@@ -792,6 +1196,31 @@ void USpatialReceiver::OnCommandResponse(Worker_CommandResponseOp& Op)
 	ReceiveCommandResponse(Op);
 }
 
+void USpatialReceiver::AddChannelWithPendingRepNotifies(USpatialActorChannel* Channel)
+{
+	ChannelsWithPendingRepNotifies.Add(Channel);
+}
+
+void USpatialReceiver::FlushRepNotifies()
+{
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialReceiverFlushRepNotifies);
+
+	// RepNotifies can resolve object references other objects are waiting on, which queues more RepNotifies.
+	while (ChannelsWithPendingRepNotifies.Num() > 0)
+	{
+		TArray<TWeakObjectPtr<USpatialActorChannel>> Channels = MoveTemp(ChannelsWithPendingRepNotifies);
+		ChannelsWithPendingRepNotifies.Reset();
+
+		for (TWeakObjectPtr<USpatialActorChannel>& Channel : Channels)
+		{
+			if (Channel.IsValid())
+			{
+				Channel->FlushRepNotifies();
+			}
+		}
+	}
+}
+
 void USpatialReceiver::FlushRetryRPCs()
 {
 	Sender->FlushRetryRPCs();
@@ -838,40 +1267,188 @@ void USpatialReceiver::ReceiveCommandResponse(Worker_CommandResponseOp& Op)
 	}
 }
 
-void USpatialReceiver::ApplyComponentUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject* TargetObject, USpatialActorChannel* Channel, bool bIsHandover)
+void USpatialReceiver::ApplyComponentUpdates(const TArray<const Worker_ComponentUpdate*>& ComponentUpdates, UObject* TargetObject, USpatialActorChannel* Channel, bool bIsHandover)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialReceiverApplyComponentUpdates);
+	SPATIALNET_SCOPE_CLASS_CYCLE_COUNTER(TargetObject->GetClass(), /* bSent */ false);
+
 	FChannelObjectPair ChannelObjectPair(Channel, TargetObject);
 
+	const bool bTraced = FLatencyTracer::HasTraces(ComponentUpdates);
+	const int64 ApplyStartTime = bTraced ? FLatencyTracer::GetTimestampMicroseconds() : 0;
+
 	FObjectReferencesMap& ObjectReferencesMap = UnresolvedRefsMap.FindOrAdd(ChannelObjectPair);
 	TSet<FUnrealObjectRef> UnresolvedRefs;
 	ComponentReader Reader(NetDriver, ObjectReferencesMap, UnresolvedRefs);
-	Reader.ApplyComponentUpdate(ComponentUpdate, TargetObject, Channel, bIsHandover);
+	Reader.ApplyComponentUpdates(ComponentUpdates, TargetObject, Channel, bIsHandover);
 
 	QueueIncomingRepUpdates(ChannelObjectPair, ObjectReferencesMap, UnresolvedRefs);
+
+	if (bTraced)
+	{
+		NetDriver->LatencyTracer.RecordTraces(ComponentUpdates, TargetObject->GetClass(), ApplyStartTime);
+	}
+}
+
+void USpatialReceiver::ReceiveMulticastUpdates(const TArray<const Worker_ComponentUpdate*>& ComponentUpdates, UObject* TargetObject, const TArray<UFunction*>& RPCArray)
+{
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialReceiverReceiveMulticastUpdates);
+
+	// Senders batch the multicast RPCs of a tick into one update, so only walk the events an update actually has.
+	TArray<Schema_FieldId> EventIndices;
+
+	for (const Worker_ComponentUpdate* ComponentUpdate : ComponentUpdates)
+	{
+		Schema_Object* EventsObject = Schema_GetComponentUpdateEvents(ComponentUpdate->schema_type);
+
+		EventIndices.SetNumUninitialized(Schema_GetUniqueFieldIdCount(EventsObject), /* bAllowShrinking */ false);
+		Schema_GetUniqueFieldIds(EventsObject, EventIndices.GetData());
+		// Events are called in order of their index, which the sender relies on to keep the RPCs in the order they were called.
+		EventIndices.Sort();
+
+		for (Schema_FieldId EventIndex : EventIndices)
+		{
+			if (EventIndex == 0 || (int32)EventIndex > RPCArray.Num())
+			{
+				UE_LOG(LogSpatialReceiver, Warning, TEXT("Received multicast RPC with an invalid index (object: %s, component: %d, index: %u)"), *TargetObject->GetName(), ComponentUpdate->component_id, EventIndex);
+				continue;
+			}
+
+			UFunction* Function = RPCArray[EventIndex - 1];
+			const uint32 EventCount = Schema_GetObjectCount(EventsObject, EventIndex);
+
+			for (uint32 i = 0; i < EventCount; i++)
+			{
+				Schema_Object* EventData = Schema_IndexObject(EventsObject, EventIndex, i);
+
+				TArray<uint8> PayloadData = GetBytesFromSchema(EventData, 1);
+				// A bit hacky, we should probably include the number of bits with the data instead.
+				int64 CountBits = PayloadData.Num() * 8;
+
+				ApplyRPC(TargetObject, Function, PayloadData, CountBits, NAME_None);
+			}
+		}
+	}
 }
 
-void USpatialReceiver::ReceiveMulticastUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject* TargetObject, const TArray<UFunction*>& RPCArray)
+void USpatialReceiver::ReceiveUnreliableRPCUpdate(const Worker_ComponentUpdate& ComponentUpdate, USpatialActorChannel* Channel, UObject* TargetObject, const TArray<UFunction*>& RPCArray)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialReceiverReceiveUnreliableRPCUpdate);
+
 	Schema_Object* EventsObject = Schema_GetComponentUpdateEvents(ComponentUpdate.schema_type);
+	const uint32 EventCount = Schema_GetObjectCount(EventsObject, SpatialConstants::UNRELIABLE_RPC_EVENT_ID);
 
-	for (Schema_FieldId EventIndex = 1; (int)EventIndex <= RPCArray.Num(); EventIndex++)
+	for (uint32 i = 0; i < EventCount; i++)
 	{
-		UFunction* Function = RPCArray[EventIndex - 1];
-		for (uint32 i = 0; i < Schema_GetObjectCount(EventsObject, EventIndex); i++)
+		Schema_Object* EventData = Schema_IndexObject(EventsObject, SpatialConstants::UNRELIABLE_RPC_EVENT_ID, i);
+
+		const uint32 Sequence = Schema_GetUint32(EventData, SpatialConstants::UNRELIABLE_RPC_SEQUENCE_ID);
+		if (!Channel->OnReceivedUnreliableRPC(ComponentUpdate.component_id, Sequence))
 		{
-			Schema_Object* EventData = Schema_IndexObject(EventsObject, EventIndex, i);
+			UE_LOG(LogSpatialReceiver, Verbose, TEXT("Dropping stale unreliable RPC (object: %s, component: %d, sequence: %u)"), *TargetObject->GetName(), ComponentUpdate.component_id, Sequence);
+			continue;
+		}
+
+		const uint32 RPCIndex = Schema_GetUint32(EventData, SpatialConstants::UNRELIABLE_RPC_INDEX_ID);
+		if ((int32)RPCIndex >= RPCArray.Num())
+		{
+			UE_LOG(LogSpatialReceiver, Warning, TEXT("Unreliable RPC index %u out of range for object %s, component %d. The schema may be out of date."), RPCIndex, *TargetObject->GetName(), ComponentUpdate.component_id);
+			continue;
+		}
+
+		TArray<uint8> PayloadData = GetBytesFromSchema(EventData, SpatialConstants::UNRELIABLE_RPC_PAYLOAD_ID);
+		// A bit hacky, we should probably include the number of bits with the data instead.
+		int64 CountBits = PayloadData.Num() * 8;
+
+		ApplyRPC(TargetObject, RPCArray[RPCIndex], PayloadData, CountBits, NAME_None);
+	}
+}
+
+void USpatialReceiver::ReceiveRingBufferRPCs(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+{
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialReceiverReceiveRingBufferRPCs);
+
+	// Like commands, the RPCs are only handled by the worker authoritative over the endpoint which acknowledges them.
+	const Worker_ComponentId AckComponentId = GetOtherRPCEndpointComponentId(ComponentId);
+	if (!StaticComponentView->HasAuthority(EntityId, AckComponentId))
+	{
+		return;
+	}
 
-			TArray<uint8> PayloadData = GetBytesFromSchema(EventData, 1);
-			// A bit hacky, we should probably include the number of bits with the data instead.
-			int64 CountBits = PayloadData.Num() * 8;
+	const RPCEndpoint* Endpoint = StaticComponentView->GetRPCEndpoint(EntityId, ComponentId);
+	if (Endpoint == nullptr)
+	{
+		return;
+	}
 
-			ApplyRPC(TargetObject, Function, PayloadData, CountBits, FString());
+	uint64* LastReceivedRPCId = LastReceivedRingBufferRPCIds.Find(EntityId);
+	if (LastReceivedRPCId == nullptr)
+	{
+		// Continue from the last acknowledgement, which may have been sent by the worker previously authoritative over the endpoint.
+		const RPCEndpoint* AckEndpoint = StaticComponentView->GetRPCEndpoint(EntityId, AckComponentId);
+		LastReceivedRPCId = &LastReceivedRingBufferRPCIds.Add(EntityId, AckEndpoint ? AckEndpoint->LastAckedRPCId : 0);
+	}
+
+	const uint64 LastSentRPCId = Endpoint->LastSentRPCId;
+	if (LastSentRPCId <= *LastReceivedRPCId)
+	{
+		return;
+	}
+
+	uint64 FirstRPCId = *LastReceivedRPCId + 1;
+	if (LastSentRPCId - *LastReceivedRPCId > SpatialConstants::RPC_RING_BUFFER_SIZE)
+	{
+		// The sender only overwrites RPCs which were acknowledged, so this can only happen if the acknowledgement state was lost.
+		UE_LOG(LogSpatialReceiver, Warning, TEXT("Entity: %lld Component: %d - %llu RPCs were overwritten before they could be received."),
+			EntityId, ComponentId, LastSentRPCId - *LastReceivedRPCId - SpatialConstants::RPC_RING_BUFFER_SIZE);
+		FirstRPCId = LastSentRPCId - SpatialConstants::RPC_RING_BUFFER_SIZE + 1;
+	}
+
+	// Set before applying the RPCs, as spawning a queued entity can replay updates to the endpoint.
+	*LastReceivedRPCId = LastSentRPCId;
+
+	// An RPC can't wait for the checkout budget, so spawn its target right away.
+	CheckoutQueuedEntity(EntityId);
+
+	const ESchemaComponentType RPCType = ComponentId == SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID ? SCHEMA_ServerRPC : SCHEMA_ClientRPC;
+
+	for (uint64 RPCId = FirstRPCId; RPCId <= LastSentRPCId; RPCId++)
+	{
+		const TOptional<RingBufferRPC>& RPC = Endpoint->GetRPC(RPCId);
+		if (!RPC.IsSet())
+		{
+			UE_LOG(LogSpatialReceiver, Warning, TEXT("Entity: %lld Component: %d - RPC %llu is missing from the ring buffer."), EntityId, ComponentId, RPCId);
+			continue;
+		}
+
+		UObject* TargetObject = PackageMap->GetObjectFromUnrealObjectRef(FUnrealObjectRef(EntityId, RPC->Offset)).Get();
+		if (TargetObject == nullptr)
+		{
+			UE_LOG(LogSpatialReceiver, Warning, TEXT("Entity: %lld Component: %d - No target object found for RPC %llu at offset %u"), EntityId, ComponentId, RPCId, RPC->Offset);
+			continue;
+		}
+
+		const TArray<UFunction*>* RPCArray = ClassInfoManager->GetOrCreateClassInfoByObject(TargetObject).RPCs.Find(RPCType);
+		if (RPCArray == nullptr || (int32)RPC->RPCIndex >= RPCArray->Num())
+		{
+			UE_LOG(LogSpatialReceiver, Warning, TEXT("Ring buffer RPC index %u out of range for object %s, component %d. The schema may be out of date."), RPC->RPCIndex, *TargetObject->GetName(), ComponentId);
+			continue;
 		}
+
+		TArray<uint8> PayloadData = RPC->PayloadData;
+		// A bit hacky, we should probably include the number of bits with the data instead.
+		int64 CountBits = PayloadData.Num() * 8;
+
+		ApplyRPC(TargetObject, (*RPCArray)[RPC->RPCIndex], PayloadData, CountBits, NAME_None);
 	}
+
+	Sender->SendRPCEndpointAck(EntityId, AckComponentId, LastSentRPCId);
 }
 
-void USpatialReceiver::ApplyRPC(UObject* TargetObject, UFunction* Function, TArray<uint8>& PayloadData, int64 CountBits, const FString& SenderWorkerId)
+void USpatialReceiver::ApplyRPC(UObject* TargetObject, UFunction* Function, TArray<uint8>& PayloadData, int64 CountBits, FName SenderWorkerId)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialReceiverApplyRPC);
+
 	uint8* Parms = (uint8*)FMemory_Alloca(Function->ParmsSize);
 	FMemory::Memzero(Parms, Function->ParmsSize);
 
@@ -901,7 +1478,13 @@ void USpatialReceiver::ApplyRPC(UObject* TargetObject, UFunction* Function, TArr
 				Actor = Cast<AActor>(TargetObject->GetOuter());
 				check(Actor);
 			}
-			NetDriver->OnReceivedReliableRPC(Actor, FunctionFlagsToRPCSchemaType(Function->FunctionFlags), SenderWorkerId, ReliableRPCId, TargetObject, Function);
+
+			// RPCs numbered 0 were sent before the actor had a channel on the sending worker, so they can't be checked.
+			USpatialActorChannel* Channel = NetDriver->GetActorChannelByEntityId(NetDriver->GetEntityRegistry()->GetEntityIdFromActor(Actor));
+			if (Channel != nullptr && ReliableRPCId != 0)
+			{
+				Channel->OnReceivedReliableRPC(FunctionFlagsToRPCSchemaType(Function->FunctionFlags), SenderWorkerId, ReliableRPCId, TargetObject, Function);
+			}
 		}
 #endif // !UE_BUILD_SHIPPING
 		TargetObject->ProcessEvent(Function, Parms);
@@ -1035,6 +1618,8 @@ TWeakObjectPtr<USpatialActorChannel> USpatialReceiver::PopPendingActorRequest(Wo
 
 void USpatialReceiver::ProcessQueuedResolvedObjects()
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialReceiverProcessQueuedResolvedObjects);
+
 	for (TPair<UObject*, FUnrealObjectRef>& It : ResolvedObjectQueue)
 	{
 		ResolvePendingOperations_Internal(It.Key, It.Value);
@@ -1068,7 +1653,7 @@ void USpatialReceiver::QueueIncomingRepUpdates(FChannelObjectPair ChannelObjectP
 	}
 }
 
-void USpatialReceiver::QueueIncomingRPC(const TSet<FUnrealObjectRef>& UnresolvedRefs, UObject* TargetObject, UFunction* Function, const TArray<uint8>& PayloadData, int64 CountBits, const FString& SenderWorkerId)
+void USpatialReceiver::QueueIncomingRPC(const TSet<FUnrealObjectRef>& UnresolvedRefs, UObject* TargetObject, UFunction* Function, const TArray<uint8>& PayloadData, int64 CountBits, FName SenderWorkerId)
 {
 	TSharedPtr<FPendingIncomingRPC> IncomingRPC = MakeShared<FPendingIncomingRPC>(UnresolvedRefs, TargetObject, Function, PayloadData, CountBits);
 #if !UE_BUILD_SHIPPING
@@ -1125,10 +1710,9 @@ void USpatialReceiver::ResolveIncomingOperations(UObject* Object, const FUnrealO
 
 		bool bStillHasUnresolved = false;
 		bool bSomeObjectsWereMapped = false;
-		TArray<UProperty*> RepNotifies;
-
 		FRepLayout& RepLayout = DependentChannel->GetObjectRepLayout(ReplicatingObject);
 		FRepStateStaticBuffer& ShadowData = DependentChannel->GetObjectStaticBuffer(ReplicatingObject);
+		TBitArray<> RepNotifies(false, RepLayout.Parents.Num());
 
 		ResolveObjectReferences(RepLayout, ReplicatingObject, *UnresolvedRefs, ShadowData.GetData(), (uint8*)ReplicatingObject, ShadowData.Num(), RepNotifies, bSomeObjectsWereMapped, bStillHasUnresolved);
 
@@ -1170,7 +1754,7 @@ void USpatialReceiver::ResolveIncomingRPCs(UObject* Object, const FUnrealObjectR
 		IncomingRPC->UnresolvedRefs.Remove(ObjectRef);
 		if (IncomingRPC->UnresolvedRefs.Num() == 0)
 		{
-			FString SenderWorkerId;
+			FName SenderWorkerId;
 #if !UE_BUILD_SHIPPING
 			SenderWorkerId = IncomingRPC->SenderWorkerId;
 #endif // !UE_BUILD_SHIPPING
@@ -1181,8 +1765,24 @@ void USpatialReceiver::ResolveIncomingRPCs(UObject* Object, const FUnrealObjectR
 	IncomingRPCMap.Remove(ObjectRef);
 }
 
-void USpatialReceiver::ResolveObjectReferences(FRepLayout& RepLayout, UObject* ReplicatedObject, FObjectReferencesMap& ObjectReferencesMap, uint8* RESTRICT StoredData, uint8* RESTRICT Data, int32 MaxAbsOffset, TArray<UProperty*>& RepNotifies, bool& bOutSomeObjectsWereMapped, bool& bOutStillHasUnresolved)
+int32 USpatialReceiver::GetNumUnresolvedRefs() const
+{
+	// Refs which only block RPCs aren't in IncomingRefsMap.
+	int32 NumUnresolvedRefs = IncomingRefsMap.Num();
+	for (const auto& IncomingRPCs : IncomingRPCMap)
+	{
+		if (!IncomingRefsMap.Contains(IncomingRPCs.Key))
+		{
+			NumUnresolvedRefs++;
+		}
+	}
+	return NumUnresolvedRefs;
+}
+
+void USpatialReceiver::ResolveObjectReferences(FRepLayout& RepLayout, UObject* ReplicatedObject, FObjectReferencesMap& ObjectReferencesMap, uint8* RESTRICT StoredData, uint8* RESTRICT Data, int32 MaxAbsOffset, TBitArray<>& RepNotifies, bool& bOutSomeObjectsWereMapped, bool& bOutStillHasUnresolved)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialReceiverResolveObjectReferences);
+
 	for (auto It = ObjectReferencesMap.CreateIterator(); It; ++It)
 	{
 		int32 AbsOffset = It.Key();
@@ -1280,7 +1880,7 @@ void USpatialReceiver::ResolveObjectReferences(FRepLayout& RepLayout, UObject* R
 			{
 				if (Parent->RepNotifyCondition == REPNOTIFY_Always || !Property->Identical(StoredData + AbsOffset, Data + AbsOffset))
 				{
-					RepNotifies.AddUnique(Parent->Property);
+					RepNotifies[ObjectReferences.ParentIndex] = true;
 				}
 			}
 		}
@@ -1296,8 +1896,10 @@ void USpatialReceiver::ResolveObjectReferences(FRepLayout& RepLayout, UObject* R
 	}
 }
 
-void USpatialReceiver::ReceiveRPCCommandRequest(const Worker_CommandRequest& CommandRequest, UObject* TargetObject, UFunction* Function, const FString& SenderWorkerId)
+void USpatialReceiver::ReceiveRPCCommandRequest(const Worker_CommandRequest& CommandRequest, UObject* TargetObject, UFunction* Function, FName SenderWorkerId)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialReceiverReceiveRPCCommandRequest);
+
 	Schema_Object* RequestObject = Schema_GetCommandRequestObject(CommandRequest.schema_type);
 
 	TArray<uint8> PayloadData = GetBytesFromSchema(RequestObject, 1);
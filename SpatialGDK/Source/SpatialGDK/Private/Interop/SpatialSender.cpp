@@ -14,6 +14,7 @@
 #include "Interop/SpatialReceiver.h"
 #include "Interop/SpatialDispatcher.h"
 #include "Schema/Interest.h"
+#include "Schema/RPCEndpoint.h"
 #include "Schema/Singleton.h"
 #include "Schema/SpawnData.h"
 #include "Schema/StandardLibrary.h"
@@ -22,6 +23,7 @@
 #include "Utils/ComponentFactory.h"
 #include "Utils/EntityRegistry.h"
 #include "Utils/RepLayoutUtils.h"
+#include "Utils/SpatialNetStats.h"
 
 DEFINE_LOG_CATEGORY(LogSpatialSender);
 
@@ -30,12 +32,19 @@ using namespace improbable;
 DECLARE_CYCLE_STAT(TEXT("SendComponentUpdates"), STAT_SpatialSenderSendComponentUpdates, STATGROUP_SpatialNet);
 DECLARE_CYCLE_STAT(TEXT("ResetOutgoingUpdate"), STAT_SpatialSenderResetOutgoingUpdate, STATGROUP_SpatialNet);
 DECLARE_CYCLE_STAT(TEXT("QueueOutgoingUpdate"), STAT_SpatialSenderQueueOutgoingUpdate, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("CreateEntity"), STAT_SpatialSenderCreateEntity, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("SendRPC"), STAT_SpatialSenderSendRPC, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("ResolveOutgoingOperations"), STAT_SpatialSenderResolveOutgoingOperations, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("FlushMulticastRPCs"), STAT_SpatialSenderFlushMulticastRPCs, STATGROUP_SpatialNet);
 
 FPendingRPCParams::FPendingRPCParams(UObject* InTargetObject, UFunction* InFunction, void* InParameters, int InRetryIndex)
 	: TargetObject(InTargetObject)
 	, Function(InFunction)
 	, Attempts(0)
 	, RetryIndex(InRetryIndex)
+#if !UE_BUILD_SHIPPING
+	, ReliableRPCIndex(0)
+#endif // !UE_BUILD_SHIPPING
 {
 	Parameters.SetNumZeroed(Function->ParmsSize);
 
@@ -62,10 +71,27 @@ void USpatialSender::Init(USpatialNetDriver* InNetDriver)
 	Receiver = InNetDriver->Receiver;
 	PackageMap = InNetDriver->PackageMap;
 	ClassInfoManager = InNetDriver->ClassInfoManager;
+	NumRetriedRPCs = 0;
+}
+
+void USpatialSender::BeginDestroy()
+{
+	// Multicasts which were never flushed, e.g. because the connection was lost.
+	for (FPendingMulticastUpdate& PendingUpdate : PendingMulticastUpdates)
+	{
+		Schema_DestroyComponentUpdate(PendingUpdate.Update.schema_type);
+	}
+
+	PendingMulticastUpdates.Empty();
+	LastPendingMulticastUpdateIndices.Empty();
+
+	Super::BeginDestroy();
 }
 
 Worker_RequestId USpatialSender::CreateEntity(USpatialActorChannel* Channel)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialSenderCreateEntity);
+
 	AActor* Actor = Channel->Actor;
 	UClass* Class = Actor->GetClass();
 
@@ -104,6 +130,12 @@ Worker_RequestId USpatialSender::CreateEntity(USpatialActorChannel* Channel)
 	ComponentWriteAcl.Add(SpatialConstants::SPAWN_DATA_COMPONENT_ID, ServersOnly);
 	ComponentWriteAcl.Add(SpatialConstants::ENTITY_ACL_COMPONENT_ID, ServersOnly);
 
+	if (NetDriver->bUseRPCRingBuffers)
+	{
+		ComponentWriteAcl.Add(SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID, OwningClientOnly);
+		ComponentWriteAcl.Add(SpatialConstants::SERVER_RPC_ENDPOINT_COMPONENT_ID, ServersOnly);
+	}
+
 	ForAllSchemaComponentTypes([&](ESchemaComponentType Type)
 	{
 		Worker_ComponentId ComponentId = Info.SchemaComponents[Type];
@@ -154,6 +186,12 @@ Worker_RequestId USpatialSender::CreateEntity(USpatialActorChannel* Channel)
 		ComponentDatas.Add(improbable::Singleton().CreateSingletonData());
 	}
 
+	if (NetDriver->bUseRPCRingBuffers)
+	{
+		ComponentDatas.Add(improbable::RPCEndpoint::CreateRPCEndpointData(SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID));
+		ComponentDatas.Add(improbable::RPCEndpoint::CreateRPCEndpointData(SpatialConstants::SERVER_RPC_ENDPOINT_COMPONENT_ID));
+	}
+
 	FUnresolvedObjectsMap UnresolvedObjectsMap;
 	FUnresolvedObjectsMap HandoverUnresolvedObjectsMap;
 	ComponentFactory DataFactory(UnresolvedObjectsMap, HandoverUnresolvedObjectsMap, NetDriver);
@@ -231,9 +269,12 @@ Worker_RequestId USpatialSender::CreateEntity(USpatialActorChannel* Channel)
 
 void USpatialSender::SendComponentUpdates(UObject* Object, const FClassInfo& Info, USpatialActorChannel* Channel, const FRepChangeState* RepChanges, const FHandoverChangeState* HandoverChanges)
 {
-	SCOPE_CYCLE_COUNTER(STAT_SpatialSenderSendComponentUpdates);
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialSenderSendComponentUpdates);
 	Worker_EntityId EntityId = Channel->GetEntityId();
 
+	const bool bTraceLatency = NetDriver->LatencyTraceSampleRate > 0.f;
+	const int64 SendStartTime = bTraceLatency ? FLatencyTracer::GetTimestampMicroseconds() : 0;
+
 	UE_LOG(LogSpatialSender, Verbose, TEXT("Sending component update (object: %s, entity: %lld)"), *Object->GetName(), EntityId);
 
 	FUnresolvedObjectsMap UnresolvedObjectsMap;
@@ -244,16 +285,14 @@ void USpatialSender::SendComponentUpdates(UObject* Object, const FClassInfo& Inf
 
 	if (RepChanges)
 	{
-		for (uint16 Handle : RepChanges->RepChanged)
+		for (TConstSetBitIterator<> It(RepChanges->RepChanged); It; ++It)
 		{
-			if (Handle > 0)
-			{
-				ResetOutgoingUpdate(Channel, Object, Handle, /* bIsHandover */ false);
+			const uint16 Handle = It.GetIndex() + 1;
+			ResetOutgoingUpdate(Channel, Object, Handle, /* bIsHandover */ false);
 
-				if (TSet<TWeakObjectPtr<const UObject>>* UnresolvedObjects = UnresolvedObjectsMap.Find(Handle))
-				{
-					QueueOutgoingUpdate(Channel, Object, Handle, *UnresolvedObjects, /* bIsHandover */ false);
-				}
+			if (TSet<TWeakObjectPtr<const UObject>>* UnresolvedObjects = UnresolvedObjectsMap.Find(Handle))
+			{
+				QueueOutgoingUpdate(Channel, Object, Handle, *UnresolvedObjects, /* bIsHandover */ false);
 			}
 		}
 	}
@@ -285,6 +324,17 @@ void USpatialSender::SendComponentUpdates(UObject* Object, const FClassInfo& Inf
 			continue;
 		}
 
+		// Only data and handover components have the latency_trace event, RPC components are never updated here.
+		if (bTraceLatency && FMath::FRand() < NetDriver->LatencyTraceSampleRate)
+		{
+			NetDriver->LatencyTracer.AddTrace(Update, SendStartTime);
+		}
+
+		if (AreDetailedNetStatsEnabled())
+		{
+			RecordComponentUpdateBytes(ClassInfoManager->GetCategoryByComponentId(Update.component_id), /* bSent */ true, Update);
+		}
+
 		Connection->SendComponentUpdate(EntityId, &Update);
 	}
 }
@@ -302,7 +352,40 @@ void USpatialSender::ProcessUpdatesQueuedUntilAuthority(Worker_EntityId EntityId
 	}
 }
 
-void FillComponentInterests(const FClassInfo& Info, bool bNetOwned, TArray<Worker_InterestOverride>& ComponentInterest)
+int32 USpatialSender::GetNumQueuedOutgoingOperations() const
+{
+	// Property updates and RPCs waiting for unresolved objects, and updates waiting for authority.
+	int32 NumQueued = 0;
+
+	for (const auto& ChannelProperties : RepPropertyToUnresolved)
+	{
+		NumQueued += ChannelProperties.Value.Num();
+	}
+
+	for (const auto& ChannelProperties : HandoverPropertyToUnresolved)
+	{
+		NumQueued += ChannelProperties.Value.Num();
+	}
+
+	for (const auto& QueuedRPCs : OutgoingRPCs)
+	{
+		NumQueued += QueuedRPCs.Value.Num();
+	}
+
+	for (const auto& QueuedUpdates : UpdatesQueuedUntilAuthorityMap)
+	{
+		NumQueued += QueuedUpdates.Value.Num();
+	}
+
+	for (const auto& RingBuffer : OutgoingRPCRingBuffers)
+	{
+		NumQueued += RingBuffer.Value.OverflowedRPCs.Num();
+	}
+
+	return NumQueued;
+}
+
+void FillComponentInterests(const FClassInfo& Info, bool bNetOwned, bool bRPCEventsInterest, bool bMulticastsCulled, TArray<Worker_InterestOverride>& ComponentInterest)
 {
 	if (Info.SchemaComponents[SCHEMA_OwnerOnly] != SpatialConstants::INVALID_COMPONENT_ID)
 	{
@@ -315,19 +398,47 @@ void FillComponentInterests(const FClassInfo& Info, bool bNetOwned, TArray<Worke
 		Worker_InterestOverride HandoverInterest = { Info.SchemaComponents[SCHEMA_Handover], false };
 		ComponentInterest.Add(HandoverInterest);
 	}
+
+	// The client and server RPC components have no data, only the unreliable RPC events of the owning client and its server.
+	if (bRPCEventsInterest && Info.SchemaComponents[SCHEMA_ClientRPC] != SpatialConstants::INVALID_COMPONENT_ID)
+	{
+		Worker_InterestOverride ClientRPCInterest = { Info.SchemaComponents[SCHEMA_ClientRPC], bNetOwned };
+		ComponentInterest.Add(ClientRPCInterest);
+	}
+
+	if (bRPCEventsInterest && Info.SchemaComponents[SCHEMA_ServerRPC] != SpatialConstants::INVALID_COMPONENT_ID)
+	{
+		Worker_InterestOverride ServerRPCInterest = { Info.SchemaComponents[SCHEMA_ServerRPC], bNetOwned };
+		ComponentInterest.Add(ServerRPCInterest);
+	}
+
+	if (CanCullMulticastRPCs(Info))
+	{
+		// Always set, as an override stays until it's replaced and the interest of an actor back in range has to be restored.
+		Worker_InterestOverride MulticastRPCInterest = { Info.SchemaComponents[SCHEMA_NetMulticastRPC], !bMulticastsCulled };
+		ComponentInterest.Add(MulticastRPCInterest);
+	}
 }
 
-TArray<Worker_InterestOverride> USpatialSender::CreateComponentInterest(AActor* Actor, bool bIsNetOwned)
+TArray<Worker_InterestOverride> USpatialSender::CreateComponentInterest(AActor* Actor, bool bIsNetOwned, bool bMulticastsCulled)
 {
 	TArray<Worker_InterestOverride> ComponentInterest;
 
 	const FClassInfo& ActorInfo = ClassInfoManager->GetOrCreateClassInfoByClass(Actor->GetClass());
-	FillComponentInterests(ActorInfo, bIsNetOwned, ComponentInterest);
+	const bool bRPCEventsInterest = NetDriver->bSendUnreliableRPCsAsEvents;
+	FillComponentInterests(ActorInfo, bIsNetOwned, bRPCEventsInterest, bMulticastsCulled, ComponentInterest);
 
 	for (auto& SubobjectInfoPair : ActorInfo.SubobjectInfo)
 	{
 		FClassInfo& SubobjectInfo = SubobjectInfoPair.Value.Get();
-		FillComponentInterests(SubobjectInfo, bIsNetOwned, ComponentInterest);
+		FillComponentInterests(SubobjectInfo, bIsNetOwned, bRPCEventsInterest, bMulticastsCulled, ComponentInterest);
+	}
+
+	// Only the owning client sends and receives RPCs through the endpoints.
+	if (NetDriver->bUseRPCRingBuffers)
+	{
+		ComponentInterest.Add(Worker_InterestOverride{ SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID, bIsNetOwned });
+		ComponentInterest.Add(Worker_InterestOverride{ SpatialConstants::SERVER_RPC_ENDPOINT_COMPONENT_ID, bIsNetOwned });
 	}
 
 	return ComponentInterest;
@@ -337,9 +448,17 @@ void USpatialSender::SendComponentInterest(AActor* Actor, Worker_EntityId Entity
 {
 	check(!NetDriver->IsServer());
 
-	const USpatialActorChannel* const ActorChannel = NetDriver->GetActorChannelByEntityId(EntityId);
+	USpatialActorChannel* const ActorChannel = NetDriver->GetActorChannelByEntityId(EntityId);
 	const bool bIsNetOwned = ActorChannel && ActorChannel->IsOwnedByWorker();
-	NetDriver->Connection->SendComponentInterest(EntityId, CreateComponentInterest(Actor, bIsNetOwned));
+
+	// Owned actors are never culled, so don't wait for the next relevancy update to get their multicasts back.
+	if (bIsNetOwned)
+	{
+		ActorChannel->SetMulticastsCulled(false);
+	}
+
+	const bool bMulticastsCulled = ActorChannel && ActorChannel->AreMulticastsCulled();
+	NetDriver->Connection->SendComponentInterest(EntityId, CreateComponentInterest(Actor, bIsNetOwned, bMulticastsCulled));
 }
 
 void USpatialSender::SendPositionUpdate(Worker_EntityId EntityId, const FVector& Location)
@@ -358,6 +477,8 @@ void USpatialSender::SendPositionUpdate(Worker_EntityId EntityId, const FVector&
 
 void USpatialSender::SendRPC(TSharedRef<FPendingRPCParams> Params)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialSenderSendRPC);
+
 	if (!Params->TargetObject.IsValid())
 	{
 		// Target object was destroyed before the RPC could be (re)sent
@@ -401,6 +522,22 @@ void USpatialSender::SendRPC(TSharedRef<FPendingRPCParams> Params)
 	case SCHEMA_ServerRPC:
 	case SCHEMA_CrossServerRPC:
 	{
+		if (NetDriver->bSendUnreliableRPCsAsEvents && RPCInfo->Type != SCHEMA_CrossServerRPC && !Params->Function->HasAnyFunctionFlags(FUNC_NetReliable))
+		{
+			if (SendUnreliableRPCEvent(TargetObject, Params->Function, Params->Parameters.GetData(), Info, *RPCInfo, UnresolvedObject))
+			{
+				break;
+			}
+		}
+
+		if (NetDriver->bUseRPCRingBuffers && RPCInfo->Type != SCHEMA_CrossServerRPC && Params->Function->HasAnyFunctionFlags(FUNC_NetReliable))
+		{
+			if (SendRingBufferRPC(Params, *RPCInfo, UnresolvedObject))
+			{
+				break;
+			}
+		}
+
 		int ReliableRPCIndex = 0;
 #if !UE_BUILD_SHIPPING
 		ReliableRPCIndex = Params->ReliableRPCIndex;
@@ -411,6 +548,17 @@ void USpatialSender::SendRPC(TSharedRef<FPendingRPCParams> Params)
 		if (!UnresolvedObject)
 		{
 			check(EntityId != SpatialConstants::INVALID_ENTITY_ID);
+
+			if (AreDetailedNetStatsEnabled())
+			{
+				RecordCommandRequestBytes(RPCInfo->Type, /* bSent */ true, CommandRequest);
+			}
+
+			if (NetDriver->BandwidthProfiler.IsRecording())
+			{
+				NetDriver->BandwidthProfiler.RecordRPC(Params->Function, Schema_GetWriteBufferLength(Schema_GetCommandRequestObject(CommandRequest.schema_type)));
+			}
+
 			Worker_RequestId RequestId = Connection->SendCommandRequest(EntityId, &CommandRequest, RPCInfo->Index + 1);
 
 			if (Params->Function->HasAnyFunctionFlags(FUNC_NetReliable))
@@ -424,23 +572,8 @@ void USpatialSender::SendRPC(TSharedRef<FPendingRPCParams> Params)
 		break;
 	}
 	case SCHEMA_NetMulticastRPC:
-	{
-		Worker_ComponentUpdate ComponentUpdate = CreateMulticastUpdate(TargetObject, Params->Function, Params->Parameters.GetData(), Info.SchemaComponents[RPCInfo->Type], RPCInfo->Index + 1, EntityId, UnresolvedObject);
-
-		if (!UnresolvedObject)
-		{
-			check(EntityId != SpatialConstants::INVALID_ENTITY_ID);
-
-			if (!NetDriver->StaticComponentView->HasAuthority(EntityId, ComponentUpdate.component_id))
-			{
-				UE_LOG(LogSpatialSender, Warning, TEXT("Trying to send MulticastRPC component update but don't have authority! Update will not be sent. Entity: %lld"), EntityId);
-				return;
-			}
-
-			Connection->SendComponentUpdate(EntityId, &ComponentUpdate);
-		}
+		SendMulticastRPC(TargetObject, Params->Function, Params->Parameters.GetData(), Info.SchemaComponents[RPCInfo->Type], RPCInfo->Index + 1, UnresolvedObject);
 		break;
-	}
 	default:
 		checkNoEntry();
 		break;
@@ -452,9 +585,186 @@ void USpatialSender::SendRPC(TSharedRef<FPendingRPCParams> Params)
 	}
 }
 
+bool USpatialSender::SendUnreliableRPCEvent(UObject* TargetObject, UFunction* Function, void* Parameters, const FClassInfo& Info, const FRPCInfo& RPCInfo, const UObject*& OutUnresolvedObject)
+{
+	// The event goes on the RPC component this worker is authoritative over: the owning client sends server RPCs on the
+	// ClientRPC component, and the server sends client RPCs on the ServerRPC component.
+	const Worker_ComponentId ComponentId = Info.SchemaComponents[RPCInfo.Type == SCHEMA_ServerRPC ? SCHEMA_ClientRPC : SCHEMA_ServerRPC];
+	if (ComponentId == SpatialConstants::INVALID_COMPONENT_ID)
+	{
+		return false;
+	}
+
+	Worker_EntityId EntityId = SpatialConstants::INVALID_ENTITY_ID;
+	Worker_ComponentUpdate ComponentUpdate = CreateUnreliableRPCUpdate(TargetObject, Function, Parameters, ComponentId, RPCInfo.Index, EntityId, OutUnresolvedObject);
+
+	if (OutUnresolvedObject)
+	{
+		return true;
+	}
+
+	check(EntityId != SpatialConstants::INVALID_ENTITY_ID);
+
+	USpatialActorChannel* Channel = NetDriver->GetActorChannelByEntityId(EntityId);
+	if (Channel == nullptr || !NetDriver->StaticComponentView->HasAuthority(EntityId, ComponentId))
+	{
+		Schema_DestroyComponentUpdate(ComponentUpdate.schema_type);
+		return false;
+	}
+
+	// The sequence is only taken once the RPC is sent, so RPCs waiting on unresolved objects don't leave gaps.
+	Schema_Object* EventData = Schema_GetObject(Schema_GetComponentUpdateEvents(ComponentUpdate.schema_type), SpatialConstants::UNRELIABLE_RPC_EVENT_ID);
+	Schema_AddUint32(EventData, SpatialConstants::UNRELIABLE_RPC_SEQUENCE_ID, Channel->GetNextUnreliableRPCSequence(ComponentId));
+
+	if (AreDetailedNetStatsEnabled())
+	{
+		RecordComponentUpdateBytes(RPCInfo.Type, /* bSent */ true, ComponentUpdate);
+	}
+
+	if (NetDriver->BandwidthProfiler.IsRecording())
+	{
+		NetDriver->BandwidthProfiler.RecordRPC(Function, Schema_GetWriteBufferLength(Schema_GetComponentUpdateEvents(ComponentUpdate.schema_type)));
+	}
+
+	Connection->SendComponentUpdate(EntityId, &ComponentUpdate);
+
+	return true;
+}
+
+bool USpatialSender::SendRingBufferRPC(TSharedRef<FPendingRPCParams> Params, const FRPCInfo& RPCInfo, const UObject*& OutUnresolvedObject)
+{
+	UObject* TargetObject = Params->TargetObject.Get();
+
+	FUnrealObjectRef TargetObjectRef(PackageMap->GetUnrealObjectRefFromNetGUID(PackageMap->GetNetGUIDFromObject(TargetObject)));
+	if (TargetObjectRef == FUnrealObjectRef::UNRESOLVED_OBJECT_REF)
+	{
+		OutUnresolvedObject = TargetObject;
+		return true;
+	}
+
+	const Worker_EntityId EntityId = TargetObjectRef.Entity;
+	const Worker_ComponentId ComponentId = GetRPCEndpointComponentId(RPCInfo.Type);
+	if (!StaticComponentView->HasAuthority(EntityId, ComponentId))
+	{
+		return false;
+	}
+
+	FOutgoingRPCRingBuffer* RingBuffer = OutgoingRPCRingBuffers.Find(EntityId);
+	if (RingBuffer == nullptr)
+	{
+		// Continue from the last RPC written to the endpoint, which may have been by the worker previously authoritative over it.
+		// Our own updates to the endpoint reach the view late, so it's only read when we start writing it.
+		const RPCEndpoint* Endpoint = StaticComponentView->GetRPCEndpoint(EntityId, ComponentId);
+		RingBuffer = &OutgoingRPCRingBuffers.Add(EntityId, FOutgoingRPCRingBuffer{ Endpoint ? Endpoint->LastSentRPCId : 0 });
+	}
+
+	// An RPC can't overtake the ones already waiting for space in the buffer.
+	const RPCEndpoint* OtherEndpoint = StaticComponentView->GetRPCEndpoint(EntityId, GetOtherRPCEndpointComponentId(ComponentId));
+	const uint64 LastAckedRPCId = OtherEndpoint ? OtherEndpoint->LastAckedRPCId : 0;
+	if (RingBuffer->OverflowedRPCs.Num() > 0 || RingBuffer->LastSentRPCId - LastAckedRPCId >= SpatialConstants::RPC_RING_BUFFER_SIZE)
+	{
+		UE_LOG(LogSpatialSender, Verbose, TEXT("RPC ring buffer full, queuing RPC %s (entity: %lld, last sent: %llu, last acked: %llu)"), *Params->Function->GetName(), EntityId, RingBuffer->LastSentRPCId, LastAckedRPCId);
+		RingBuffer->OverflowedRPCs.Add(Params);
+		return true;
+	}
+
+	TSet<TWeakObjectPtr<const UObject>> UnresolvedObjects;
+	FSpatialNetBitWriter PayloadWriter(PackageMap, UnresolvedObjects);
+
+#if !UE_BUILD_SHIPPING
+	// ApplyRPC reads the reliable RPC index of every reliable RPC, but the ring buffer already keeps them in order.
+	int ReliableRPCId = 0;
+	PayloadWriter << ReliableRPCId;
+#endif // !UE_BUILD_SHIPPING
+
+	TSharedPtr<FRepLayout> RepLayout = NetDriver->GetFunctionRepLayout(Params->Function);
+	RepLayout_SendPropertiesForRPC(*RepLayout, PayloadWriter, Params->Parameters.GetData());
+
+	for (TWeakObjectPtr<const UObject> Object : UnresolvedObjects)
+	{
+		if (Object.IsValid())
+		{
+			// Take the first unresolved object
+			OutUnresolvedObject = Object.Get();
+			return true;
+		}
+	}
+
+	const uint64 RPCId = ++RingBuffer->LastSentRPCId;
+
+	Worker_ComponentUpdate ComponentUpdate = {};
+	ComponentUpdate.component_id = ComponentId;
+	ComponentUpdate.schema_type = Schema_CreateComponentUpdate(ComponentId);
+	Schema_Object* ComponentObject = Schema_GetComponentUpdateFields(ComponentUpdate.schema_type);
+
+	Schema_AddUint64(ComponentObject, SpatialConstants::RPC_ENDPOINT_LAST_SENT_RPC_ID_ID, RPCId);
+	Schema_Object* RPCObject = Schema_AddObject(ComponentObject, RPCEndpoint::GetRingBufferFieldId(RPCId));
+	Schema_AddUint32(RPCObject, SpatialConstants::RING_BUFFER_RPC_OFFSET_ID, TargetObjectRef.Offset);
+	Schema_AddUint32(RPCObject, SpatialConstants::RING_BUFFER_RPC_INDEX_ID, RPCInfo.Index);
+	AddBytesToSchema(RPCObject, SpatialConstants::RING_BUFFER_RPC_PAYLOAD_ID, PayloadWriter);
+
+	if (AreDetailedNetStatsEnabled())
+	{
+		RecordComponentUpdateBytes(RPCInfo.Type, /* bSent */ true, ComponentUpdate);
+	}
+
+	if (NetDriver->BandwidthProfiler.IsRecording())
+	{
+		NetDriver->BandwidthProfiler.RecordRPC(Params->Function, Schema_GetWriteBufferLength(RPCObject));
+	}
+
+	Connection->SendComponentUpdate(EntityId, &ComponentUpdate);
+
+	return true;
+}
+
+void USpatialSender::SendRPCEndpointAck(Worker_EntityId EntityId, Worker_ComponentId ComponentId, uint64 LastAckedRPCId)
+{
+	Worker_ComponentUpdate ComponentUpdate = RPCEndpoint::CreateAckUpdate(ComponentId, LastAckedRPCId);
+	Connection->SendComponentUpdate(EntityId, &ComponentUpdate);
+}
+
+void USpatialSender::FlushOverflowedRingBufferRPCs(Worker_EntityId EntityId)
+{
+	FOutgoingRPCRingBuffer* RingBuffer = OutgoingRPCRingBuffers.Find(EntityId);
+	if (RingBuffer == nullptr || RingBuffer->OverflowedRPCs.Num() == 0)
+	{
+		return;
+	}
+
+	// Whatever still doesn't fit is queued again, in the same order.
+	TArray<TSharedRef<FPendingRPCParams>> OverflowedRPCs = MoveTemp(RingBuffer->OverflowedRPCs);
+	RingBuffer->OverflowedRPCs.Reset();
+
+	for (TSharedRef<FPendingRPCParams>& Params : OverflowedRPCs)
+	{
+		SendRPC(Params);
+	}
+}
+
+void USpatialSender::OnRPCEndpointAuthorityLost(Worker_EntityId EntityId)
+{
+	FOutgoingRPCRingBuffer RingBuffer;
+	if (!OutgoingRPCRingBuffers.RemoveAndCopyValue(EntityId, RingBuffer))
+	{
+		return;
+	}
+
+	for (TSharedRef<FPendingRPCParams>& Params : RingBuffer.OverflowedRPCs)
+	{
+		SendRPC(Params);
+	}
+}
+
+void USpatialSender::RemoveRPCRingBuffer(Worker_EntityId EntityId)
+{
+	OutgoingRPCRingBuffers.Remove(EntityId);
+}
+
 void USpatialSender::EnqueueRetryRPC(TSharedRef<FPendingRPCParams> Params)
 {
 	RetryRPCs.Add(Params);
+	NumRetriedRPCs++;
 }
 
 void USpatialSender::FlushRetryRPCs()
@@ -487,12 +797,15 @@ void USpatialSender::SendCreateEntityRequest(USpatialActorChannel* Channel)
 
 void USpatialSender::SendDeleteEntityRequest(Worker_EntityId EntityId)
 {
+	// Multicasts called right before destroying an actor, e.g. to play an effect, have to reach clients before the entity is gone.
+	FlushMulticastRPCs(EntityId);
+
 	Connection->SendDeleteEntityRequest(EntityId);
 }
 
 void USpatialSender::ResetOutgoingUpdate(USpatialActorChannel* DependentChannel, UObject* ReplicatedObject, int16 Handle, bool bIsHandover)
 {
-	SCOPE_CYCLE_COUNTER(STAT_SpatialSenderResetOutgoingUpdate);
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialSenderResetOutgoingUpdate);
 
 	check(DependentChannel);
 	check(ReplicatedObject);
@@ -548,7 +861,7 @@ void USpatialSender::ResetOutgoingUpdate(USpatialActorChannel* DependentChannel,
 
 void USpatialSender::QueueOutgoingUpdate(USpatialActorChannel* DependentChannel, UObject* ReplicatedObject, int16 Handle, const TSet<TWeakObjectPtr<const UObject>>& UnresolvedObjects, bool bIsHandover)
 {
-	SCOPE_CYCLE_COUNTER(STAT_SpatialSenderQueueOutgoingUpdate);
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialSenderQueueOutgoingUpdate);
 	check(DependentChannel);
 	check(ReplicatedObject);
 	FChannelObjectPair ChannelObjectPair(DependentChannel, ReplicatedObject);
@@ -639,14 +952,145 @@ Worker_CommandRequest USpatialSender::CreateRPCCommandRequest(UObject* TargetObj
 	return CommandRequest;
 }
 
-Worker_ComponentUpdate USpatialSender::CreateMulticastUpdate(UObject* TargetObject, UFunction* Function, void* Parameters, Worker_ComponentId ComponentId, Schema_FieldId EventIndex, Worker_EntityId& OutEntityId, const UObject*& OutUnresolvedObject)
+void USpatialSender::SendMulticastRPC(UObject* TargetObject, UFunction* Function, void* Parameters, Worker_ComponentId ComponentId, Schema_FieldId EventIndex, const UObject*& OutUnresolvedObject)
+{
+	FUnrealObjectRef TargetObjectRef(PackageMap->GetUnrealObjectRefFromNetGUID(PackageMap->GetNetGUIDFromObject(TargetObject)));
+	if (TargetObjectRef == FUnrealObjectRef::UNRESOLVED_OBJECT_REF)
+	{
+		OutUnresolvedObject = TargetObject;
+		return;
+	}
+
+	const Worker_EntityId EntityId = TargetObjectRef.Entity;
+
+	TSet<TWeakObjectPtr<const UObject>> UnresolvedObjects;
+	FSpatialNetBitWriter PayloadWriter(PackageMap, UnresolvedObjects);
+
+	TSharedPtr<FRepLayout> RepLayout = NetDriver->GetFunctionRepLayout(Function);
+	RepLayout_SendPropertiesForRPC(*RepLayout, PayloadWriter, Parameters);
+
+	for (TWeakObjectPtr<const UObject> Object : UnresolvedObjects)
+	{
+		if (Object.IsValid())
+		{
+			// Take the first unresolved object
+			OutUnresolvedObject = Object.Get();
+			return;
+		}
+	}
+
+	if (!NetDriver->StaticComponentView->HasAuthority(EntityId, ComponentId))
+	{
+		UE_LOG(LogSpatialSender, Warning, TEXT("Trying to send MulticastRPC component update but don't have authority! Update will not be sent. Entity: %lld"), EntityId);
+		return;
+	}
+
+	Schema_Object* EventData = AddBatchedMulticastEvent(EntityId, ComponentId, EventIndex);
+	AddBytesToSchema(EventData, 1, PayloadWriter);
+
+	if (NetDriver->BandwidthProfiler.IsRecording())
+	{
+		NetDriver->BandwidthProfiler.RecordRPC(Function, Schema_GetWriteBufferLength(EventData));
+	}
+}
+
+Schema_Object* USpatialSender::AddBatchedMulticastEvent(Worker_EntityId EntityId, Worker_ComponentId ComponentId, Schema_FieldId EventIndex)
+{
+	// Only the last update of the entity is added to, so the RPCs of an entity are sent in the order they were called. The receiver
+	// calls the events of an update in order of their index, so an event with a lower index than the last one added starts a new update.
+	int32* UpdateIndex = LastPendingMulticastUpdateIndices.Find(EntityId);
+	if (UpdateIndex == nullptr
+		|| PendingMulticastUpdates[*UpdateIndex].Update.component_id != ComponentId
+		|| PendingMulticastUpdates[*UpdateIndex].LastEventIndex > EventIndex)
+	{
+		FPendingMulticastUpdate PendingUpdate;
+		PendingUpdate.EntityId = EntityId;
+		PendingUpdate.Update.component_id = ComponentId;
+		PendingUpdate.Update.schema_type = Schema_CreateComponentUpdate(ComponentId);
+
+		UpdateIndex = &LastPendingMulticastUpdateIndices.Add(EntityId, PendingMulticastUpdates.Add(PendingUpdate));
+	}
+
+	FPendingMulticastUpdate& PendingUpdate = PendingMulticastUpdates[*UpdateIndex];
+	PendingUpdate.LastEventIndex = EventIndex;
+
+	return Schema_AddObject(Schema_GetComponentUpdateEvents(PendingUpdate.Update.schema_type), EventIndex);
+}
+
+void USpatialSender::SendPendingMulticastUpdate(FPendingMulticastUpdate& PendingUpdate)
+{
+	if (Connection == nullptr || !Connection->IsConnected())
+	{
+		Schema_DestroyComponentUpdate(PendingUpdate.Update.schema_type);
+		return;
+	}
+
+	if (!NetDriver->StaticComponentView->HasAuthority(PendingUpdate.EntityId, PendingUpdate.Update.component_id))
+	{
+		UE_LOG(LogSpatialSender, Warning, TEXT("Lost authority before batched MulticastRPC component update could be sent! Update will not be sent. Entity: %lld"), PendingUpdate.EntityId);
+		Schema_DestroyComponentUpdate(PendingUpdate.Update.schema_type);
+		return;
+	}
+
+	if (AreDetailedNetStatsEnabled())
+	{
+		RecordComponentUpdateBytes(SCHEMA_NetMulticastRPC, /* bSent */ true, PendingUpdate.Update);
+	}
+
+	Connection->SendComponentUpdate(PendingUpdate.EntityId, &PendingUpdate.Update);
+}
+
+void USpatialSender::FlushMulticastRPCs()
+{
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialSenderFlushMulticastRPCs);
+
+	for (FPendingMulticastUpdate& PendingUpdate : PendingMulticastUpdates)
+	{
+		SendPendingMulticastUpdate(PendingUpdate);
+	}
+
+	PendingMulticastUpdates.Reset();
+	LastPendingMulticastUpdateIndices.Reset();
+}
+
+void USpatialSender::FlushMulticastRPCs(Worker_EntityId EntityId)
+{
+	if (!LastPendingMulticastUpdateIndices.Contains(EntityId))
+	{
+		return;
+	}
+
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialSenderFlushMulticastRPCs);
+
+	for (FPendingMulticastUpdate& PendingUpdate : PendingMulticastUpdates)
+	{
+		if (PendingUpdate.EntityId == EntityId)
+		{
+			SendPendingMulticastUpdate(PendingUpdate);
+		}
+	}
+
+	PendingMulticastUpdates.RemoveAll([EntityId](const FPendingMulticastUpdate& PendingUpdate)
+	{
+		return PendingUpdate.EntityId == EntityId;
+	});
+
+	// The updates of other entities moved, so their indices have to be found again.
+	LastPendingMulticastUpdateIndices.Reset();
+	for (int32 Index = 0; Index < PendingMulticastUpdates.Num(); Index++)
+	{
+		LastPendingMulticastUpdateIndices.Add(PendingMulticastUpdates[Index].EntityId, Index);
+	}
+}
+
+Worker_ComponentUpdate USpatialSender::CreateUnreliableRPCUpdate(UObject* TargetObject, UFunction* Function, void* Parameters, Worker_ComponentId ComponentId, uint32 RPCIndex, Worker_EntityId& OutEntityId, const UObject*& OutUnresolvedObject)
 {
 	Worker_ComponentUpdate ComponentUpdate = {};
 
 	ComponentUpdate.component_id = ComponentId;
 	ComponentUpdate.schema_type = Schema_CreateComponentUpdate(ComponentId);
 	Schema_Object* EventsObject = Schema_GetComponentUpdateEvents(ComponentUpdate.schema_type);
-	Schema_Object* EventData = Schema_AddObject(EventsObject, EventIndex);
+	Schema_Object* EventData = Schema_AddObject(EventsObject, SpatialConstants::UNRELIABLE_RPC_EVENT_ID);
 
 	FUnrealObjectRef TargetObjectRef(PackageMap->GetUnrealObjectRefFromNetGUID(PackageMap->GetNetGUIDFromObject(TargetObject)));
 	if (TargetObjectRef == FUnrealObjectRef::UNRESOLVED_OBJECT_REF)
@@ -675,7 +1119,8 @@ Worker_ComponentUpdate USpatialSender::CreateMulticastUpdate(UObject* TargetObje
 		}
 	}
 
-	AddBytesToSchema(EventData, 1, PayloadWriter);
+	AddBytesToSchema(EventData, SpatialConstants::UNRELIABLE_RPC_PAYLOAD_ID, PayloadWriter);
+	Schema_AddUint32(EventData, SpatialConstants::UNRELIABLE_RPC_INDEX_ID, RPCIndex);
 
 	return ComponentUpdate;
 }
@@ -687,6 +1132,8 @@ void USpatialSender::SendCommandResponse(Worker_RequestId request_id, Worker_Com
 
 void USpatialSender::ResolveOutgoingOperations(UObject* Object, bool bIsHandover)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialSenderResolveOutgoingOperations);
+
 	// Choose the correct container based on whether it's handover or not
 	FChannelToHandleToUnresolved& PropertyToUnresolved = bIsHandover ? HandoverPropertyToUnresolved : RepPropertyToUnresolved;
 	FOutgoingRepUpdates& ObjectToUnresolved = bIsHandover ? HandoverObjectToUnresolved : RepObjectToUnresolved;
@@ -723,13 +1170,6 @@ void USpatialSender::ResolveOutgoingOperations(UObject* Object, bool bIsHandover
 			{
 				PropertyHandles.Add(Handle);
 
-				// Hack to figure out if this property is an array to add extra handles
-				if (!bIsHandover && DependentChannel->IsDynamicArrayHandle(ReplicatingObject, Handle))
-				{
-					PropertyHandles.Add(0);
-					PropertyHandles.Add(0);
-				}
-
 				FHandleToUnresolved& AnotherHandleToUnresolved = PropertyToUnresolved.FindChecked(ChannelObjectPair);
 				AnotherHandleToUnresolved.Remove(Handle);
 				if (AnotherHandleToUnresolved.Num() == 0)
@@ -747,9 +1187,11 @@ void USpatialSender::ResolveOutgoingOperations(UObject* Object, bool bIsHandover
 			}
 			else
 			{
-				// End with zero to indicate the end of the list of handles.
-				PropertyHandles.Add(0);
-				FRepChangeState RepChangeState = { PropertyHandles, DependentChannel->GetObjectRepLayout(ReplicatingObject) };
+				FRepChangeState RepChangeState(DependentChannel->GetObjectRepLayout(ReplicatingObject));
+				for (uint16 Handle : PropertyHandles)
+				{
+					RepChangeState.MarkChanged(Handle);
+				}
 				SendComponentUpdates(ReplicatingObject, Info, DependentChannel, &RepChangeState, nullptr);
 			}
 		}
@@ -824,6 +1266,11 @@ bool USpatialSender::UpdateEntityACLs(AActor* Actor, Worker_EntityId EntityId)
 
 	EntityACL->ComponentWriteAcl.Add(Info.SchemaComponents[SCHEMA_ClientRPC], OwningClientOnly);
 
+	if (EntityACL->ComponentWriteAcl.Contains(SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID))
+	{
+		EntityACL->ComponentWriteAcl.Add(SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID, OwningClientOnly);
+	}
+
 	for (auto& SubobjectInfoPair : Info.SubobjectInfo)
 	{
 		const FClassInfo& SubobjectInfo = SubobjectInfoPair.Value.Get();
@@ -26,20 +26,66 @@ bool USpatialStaticComponentView::HasAuthority(Worker_EntityId EntityId, Worker_
 	return GetAuthority(EntityId, ComponentId) == WORKER_AUTHORITY_AUTHORITATIVE;
 }
 
+improbable::RPCEndpoint* USpatialStaticComponentView::GetRPCEndpoint(Worker_EntityId EntityId, Worker_ComponentId ComponentId)
+{
+	if (ComponentId == SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID)
+	{
+		return GetComponentData<improbable::ClientRPCEndpoint>(EntityId);
+	}
+
+	check(ComponentId == SpatialConstants::SERVER_RPC_ENDPOINT_COMPONENT_ID);
+	return GetComponentData<improbable::ServerRPCEndpoint>(EntityId);
+}
+
+namespace
+{
+	// Pooled storage per component type is bounded by the number of entities in view, this only caps pathological cases.
+	const int32 MaxPooledComponentStorage = 4096;
+}
+
+template <typename T>
+TUniquePtr<improbable::ComponentStorageBase> USpatialStaticComponentView::CreateComponentStorage(const Worker_ComponentData& Data)
+{
+	if (TArray<TUniquePtr<improbable::ComponentStorageBase>>* Pool = ComponentStoragePool.Find(T::ComponentId))
+	{
+		if (Pool->Num() > 0)
+		{
+			TUniquePtr<improbable::ComponentStorageBase> Storage = Pool->Pop(/* bAllowShrinking */ false);
+			static_cast<improbable::ComponentStorage<T>*>(Storage.Get())->Get().ApplyComponentData(Data);
+			return Storage;
+		}
+	}
+
+	return MakeUnique<improbable::ComponentStorage<T>>(Data);
+}
+
+template <typename T>
+void USpatialStaticComponentView::ApplyComponentData(Worker_EntityId EntityId, const Worker_ComponentData& Data)
+{
+	// Re-adding a component that is already in the view overwrites the existing storage in place.
+	if (T* Component = GetComponentData<T>(EntityId))
+	{
+		Component->ApplyComponentData(Data);
+		return;
+	}
+
+	EntityComponentMap.FindOrAdd(EntityId).Add(T::ComponentId, CreateComponentStorage<T>(Data));
+}
+
 void USpatialStaticComponentView::OnAddComponent(const Worker_AddComponentOp& Op)
 {
 	TUniquePtr<improbable::ComponentStorageBase> Data;
 	switch (Op.data.component_id)
 	{
 	case SpatialConstants::ENTITY_ACL_COMPONENT_ID:
-		Data = MakeUnique<improbable::ComponentStorage<improbable::EntityAcl>>(Op.data);
-		break;
+		ApplyComponentData<improbable::EntityAcl>(Op.entity_id, Op.data);
+		return;
 	case SpatialConstants::METADATA_COMPONENT_ID:
-		Data = MakeUnique<improbable::ComponentStorage<improbable::Metadata>>(Op.data);
-		break;
+		ApplyComponentData<improbable::Metadata>(Op.entity_id, Op.data);
+		return;
 	case SpatialConstants::POSITION_COMPONENT_ID:
-		Data = MakeUnique<improbable::ComponentStorage<improbable::Position>>(Op.data);
-		break;
+		ApplyComponentData<improbable::Position>(Op.entity_id, Op.data);
+		return;
 	case SpatialConstants::PERSISTENCE_COMPONENT_ID:
 		Data = MakeUnique<improbable::ComponentStorage<improbable::Persistence>>(Op.data);
 		break;
@@ -55,6 +101,12 @@ void USpatialStaticComponentView::OnAddComponent(const Worker_AddComponentOp& Op
 	case SpatialConstants::INTEREST_COMPONENT_ID:
 		Data = MakeUnique<improbable::ComponentStorage<improbable::Interest>>(Op.data);
 		break;
+	case SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID:
+		Data = MakeUnique<improbable::ComponentStorage<improbable::ClientRPCEndpoint>>(Op.data);
+		break;
+	case SpatialConstants::SERVER_RPC_ENDPOINT_COMPONENT_ID:
+		Data = MakeUnique<improbable::ComponentStorage<improbable::ServerRPCEndpoint>>(Op.data);
+		break;
 	default:
 		return;
 	}
@@ -64,6 +116,29 @@ void USpatialStaticComponentView::OnAddComponent(const Worker_AddComponentOp& Op
 
 void USpatialStaticComponentView::OnRemoveEntity(const Worker_RemoveEntityOp& Op)
 {
+	if (TMap<Worker_ComponentId, TUniquePtr<improbable::ComponentStorageBase>>* ComponentStorageMap = EntityComponentMap.Find(Op.entity_id))
+	{
+		for (auto& ComponentStoragePair : *ComponentStorageMap)
+		{
+			switch (ComponentStoragePair.Key)
+			{
+			case SpatialConstants::ENTITY_ACL_COMPONENT_ID:
+			case SpatialConstants::METADATA_COMPONENT_ID:
+			case SpatialConstants::POSITION_COMPONENT_ID:
+			{
+				TArray<TUniquePtr<improbable::ComponentStorageBase>>& Pool = ComponentStoragePool.FindOrAdd(ComponentStoragePair.Key);
+				if (Pool.Num() < MaxPooledComponentStorage)
+				{
+					Pool.Add(MoveTemp(ComponentStoragePair.Value));
+				}
+				break;
+			}
+			default:
+				break;
+			}
+		}
+	}
+
 	EntityComponentMap.Remove(Op.entity_id);
 }
 
@@ -79,6 +154,12 @@ void USpatialStaticComponentView::OnComponentUpdate(const Worker_ComponentUpdate
 	case SpatialConstants::POSITION_COMPONENT_ID:
 		Component = GetComponentData<improbable::Position>(Op.entity_id);
 		break;
+	case SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID:
+		Component = GetComponentData<improbable::ClientRPCEndpoint>(Op.entity_id);
+		break;
+	case SpatialConstants::SERVER_RPC_ENDPOINT_COMPONENT_ID:
+		Component = GetComponentData<improbable::ServerRPCEndpoint>(Op.entity_id);
+		break;
 	default:
 		return;
 	}
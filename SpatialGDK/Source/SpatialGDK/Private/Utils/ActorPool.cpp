@@ -0,0 +1,172 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/ActorPool.h"
+
+#include "Components/ActorComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "TimerManager.h"
+
+#include "EngineClasses/SpatialNetDriver.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogActorPool, Log, All);
+DEFINE_LOG_CATEGORY(LogActorPool);
+
+void UActorPool::Init(USpatialNetDriver* InNetDriver)
+{
+	NetDriver = InNetDriver;
+
+	for (const FSoftClassPath& ClassPath : NetDriver->PooledActorClasses)
+	{
+		if (UClass* Class = ClassPath.TryLoadClass<AActor>())
+		{
+			PooledClasses.Add(Class);
+		}
+		else
+		{
+			UE_LOG(LogActorPool, Warning, TEXT("Could not load pooled actor class %s, actors of this class will not be pooled."), *ClassPath.ToString());
+		}
+	}
+}
+
+bool UActorPool::IsPooledClass(UClass* Class)
+{
+	if (PooledClasses.Num() == 0 || Class == nullptr)
+	{
+		return false;
+	}
+
+	if (bool* bIsPooled = IsPooledClassCache.Find(Class))
+	{
+		return *bIsPooled;
+	}
+
+	bool bIsPooled = false;
+	for (UClass* PooledClass : PooledClasses)
+	{
+		if (Class->IsChildOf(PooledClass))
+		{
+			bIsPooled = true;
+			break;
+		}
+	}
+
+	IsPooledClassCache.Add(Class, bIsPooled);
+	return bIsPooled;
+}
+
+bool UActorPool::HasCapacity(UClass* Class) const
+{
+	const TArray<TWeakObjectPtr<AActor>>* Actors = PooledActors.Find(Class);
+	const int32 NumPooled = Actors != nullptr ? Actors->Num() : 0;
+	return NumPooled < NetDriver->MaxPooledActorsPerClass;
+}
+
+AActor* UActorPool::AcquireActor(UClass* Class, const FTransform& Transform)
+{
+	TArray<TWeakObjectPtr<AActor>>* Actors = PooledActors.Find(Class);
+	if (Actors == nullptr)
+	{
+		return nullptr;
+	}
+
+	while (Actors->Num() > 0)
+	{
+		AActor* Actor = Actors->Pop(/* bAllowShrinking */ false).Get();
+		if (Actor == nullptr || Actor->IsPendingKill())
+		{
+			// Destroyed while pooled, e.g. by a level streaming out.
+			continue;
+		}
+
+		const AActor* DefaultActor = Class->GetDefaultObject<AActor>();
+
+		Actor->SetActorTransform(Transform, /* bSweep */ false, nullptr, ETeleportType::TeleportPhysics);
+		Actor->SetActorHiddenInGame(DefaultActor->bHidden);
+		Actor->SetActorEnableCollision(DefaultActor->GetActorEnableCollision());
+		Actor->SetActorTickEnabled(DefaultActor->PrimaryActorTick.bStartWithTickEnabled);
+
+		for (UActorComponent* Component : Actor->GetComponents())
+		{
+			if (Component == nullptr)
+			{
+				continue;
+			}
+
+			// Activating enables ticking, so restore the component's own tick setting afterwards.
+			if (Component->bAutoActivate)
+			{
+				Component->Activate(/* bReset */ true);
+			}
+			Component->SetComponentTickEnabled(Component->PrimaryComponentTick.bStartWithTickEnabled);
+		}
+
+		UE_LOG(LogActorPool, Verbose, TEXT("Reusing pooled actor %s."), *Actor->GetName());
+
+		return Actor;
+	}
+
+	return nullptr;
+}
+
+bool UActorPool::ReleaseActor(AActor* Actor)
+{
+	if (!IsPooledClass(Actor->GetClass()))
+	{
+		return false;
+	}
+
+	TArray<TWeakObjectPtr<AActor>>& Actors = PooledActors.FindOrAdd(Actor->GetClass());
+	if (Actors.Num() >= NetDriver->MaxPooledActorsPerClass)
+	{
+		return false;
+	}
+
+	// Give game code a chance to clear any state that shouldn't carry over to the next entity.
+	Actor->Reset();
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+
+	// Components would otherwise keep simulating the hidden actor, e.g. projectile movement, audio or particles.
+	FTimerManager& TimerManager = Actor->GetWorldTimerManager();
+	TimerManager.ClearAllTimersForObject(Actor);
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (Component == nullptr)
+		{
+			continue;
+		}
+
+		TimerManager.ClearAllTimersForObject(Component);
+		Component->Deactivate();
+		Component->SetComponentTickEnabled(false);
+	}
+
+	Actor->Role = ROLE_None;
+	Actor->RemoteRole = ROLE_None;
+
+	Actors.Add(Actor);
+
+	UE_LOG(LogActorPool, Verbose, TEXT("Pooled actor %s, %d actors of class %s pooled."), *Actor->GetName(), Actors.Num(), *Actor->GetClass()->GetName());
+
+	return true;
+}
+
+void UActorPool::Empty()
+{
+	for (TPair<TWeakObjectPtr<UClass>, TArray<TWeakObjectPtr<AActor>>>& Pair : PooledActors)
+	{
+		for (TWeakObjectPtr<AActor>& Actor : Pair.Value)
+		{
+			if (Actor.IsValid())
+			{
+				Actor->Destroy(true);
+			}
+		}
+	}
+
+	PooledActors.Empty();
+	IsPooledClassCache.Empty();
+}
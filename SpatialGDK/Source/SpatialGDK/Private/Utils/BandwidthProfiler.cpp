@@ -0,0 +1,194 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/BandwidthProfiler.h"
+
+#include "Misc/OutputDevice.h"
+#include "UObject/Class.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+
+const TCHAR* GetSchemaComponentTypeName(ESchemaComponentType Type)
+{
+	switch (Type)
+	{
+	case SCHEMA_Data:
+		return TEXT("Data");
+	case SCHEMA_OwnerOnly:
+		return TEXT("OwnerOnly");
+	case SCHEMA_Handover:
+		return TEXT("Handover");
+	case SCHEMA_ClientRPC:
+		return TEXT("ClientRPC");
+	case SCHEMA_ServerRPC:
+		return TEXT("ServerRPC");
+	case SCHEMA_NetMulticastRPC:
+		return TEXT("NetMulticastRPC");
+	case SCHEMA_CrossServerRPC:
+		return TEXT("CrossServerRPC");
+	default:
+		return TEXT("Invalid");
+	}
+}
+
+}
+
+void FBandwidthProfiler::FBandwidthEntry::Add(uint32 NumBytes)
+{
+	CurrentWindow.Bytes += NumBytes;
+	CurrentWindow.Count++;
+	Total.Bytes += NumBytes;
+	Total.Count++;
+}
+
+FBandwidthProfiler::FBandwidthProfiler()
+	: bRecording(false)
+	, WindowSeconds(5.f)
+	, CurrentWindowTime(0.f)
+	, LastWindowTime(0.f)
+	, TotalTime(0.f)
+{
+}
+
+void FBandwidthProfiler::StartRecording(float InWindowSeconds)
+{
+	if (InWindowSeconds > 0.f)
+	{
+		WindowSeconds = InWindowSeconds;
+	}
+
+	bRecording = true;
+}
+
+void FBandwidthProfiler::StopRecording()
+{
+	bRecording = false;
+}
+
+void FBandwidthProfiler::Reset()
+{
+	FieldEntries.Empty();
+	RPCEntries.Empty();
+
+	CurrentWindowTime = 0.f;
+	LastWindowTime = 0.f;
+	TotalTime = 0.f;
+}
+
+void FBandwidthProfiler::Tick(float DeltaTime)
+{
+	CurrentWindowTime += DeltaTime;
+	TotalTime += DeltaTime;
+
+	if (CurrentWindowTime < WindowSeconds)
+	{
+		return;
+	}
+
+	auto CompleteWindow = [](FBandwidthEntry& Entry)
+	{
+		Entry.LastWindow = Entry.CurrentWindow;
+		Entry.CurrentWindow = FByteCount();
+	};
+
+	for (auto& Pair : FieldEntries)
+	{
+		CompleteWindow(Pair.Value);
+	}
+
+	for (auto& Pair : RPCEntries)
+	{
+		CompleteWindow(Pair.Value);
+	}
+
+	LastWindowTime = CurrentWindowTime;
+	CurrentWindowTime = 0.f;
+}
+
+void FBandwidthProfiler::RecordField(UClass* Class, ESchemaComponentType Type, Schema_FieldId FieldId, UProperty* Property, uint32 NumBytes)
+{
+	const FFieldKey Key(FName(*Class->GetPathName()), Type, FieldId);
+	FBandwidthEntry* Entry = FieldEntries.Find(Key);
+	if (Entry == nullptr)
+	{
+		Entry = &FieldEntries.Add(Key);
+		Entry->Name = FString::Printf(TEXT("%s %s %u (%s)"), *Class->GetName(), GetSchemaComponentTypeName(Type), FieldId, *Property->GetName());
+	}
+
+	Entry->Add(NumBytes);
+}
+
+void FBandwidthProfiler::RecordRPC(UFunction* Function, uint32 NumBytes)
+{
+	const FName FunctionPath(*Function->GetPathName());
+	FBandwidthEntry* Entry = RPCEntries.Find(FunctionPath);
+	if (Entry == nullptr)
+	{
+		Entry = &RPCEntries.Add(FunctionPath);
+		Entry->Name = FString::Printf(TEXT("%s::%s"), *Function->GetOwnerClass()->GetName(), *Function->GetName());
+	}
+
+	Entry->Add(NumBytes);
+}
+
+void FBandwidthProfiler::Dump(FOutputDevice& Ar, int32 MaxEntries) const
+{
+	TArray<const FBandwidthEntry*> Fields;
+	for (const auto& Pair : FieldEntries)
+	{
+		Fields.Add(&Pair.Value);
+	}
+
+	TArray<const FBandwidthEntry*> RPCs;
+	for (const auto& Pair : RPCEntries)
+	{
+		RPCs.Add(&Pair.Value);
+	}
+
+	Ar.Logf(TEXT("Spatial bandwidth profiler: %s, %.1fs recorded, %.1fs window"), bRecording ? TEXT("recording") : TEXT("stopped"), TotalTime, WindowSeconds);
+
+	DumpEntries(Ar, TEXT("Properties"), Fields, MaxEntries);
+	DumpEntries(Ar, TEXT("RPCs"), RPCs, MaxEntries);
+}
+
+void FBandwidthProfiler::DumpEntries(FOutputDevice& Ar, const TCHAR* Title, const TArray<const FBandwidthEntry*>& Entries, int32 MaxEntries) const
+{
+	// Until the first window completes, the window in progress is the best there is.
+	const bool bHasLastWindow = LastWindowTime > 0.f;
+	const float WindowTime = bHasLastWindow ? LastWindowTime : CurrentWindowTime;
+	auto GetWindow = [bHasLastWindow](const FBandwidthEntry* Entry) -> const FByteCount&
+	{
+		return bHasLastWindow ? Entry->LastWindow : Entry->CurrentWindow;
+	};
+
+	TArray<const FBandwidthEntry*> SortedEntries = Entries;
+	SortedEntries.Sort([&GetWindow](const FBandwidthEntry& A, const FBandwidthEntry& B)
+	{
+		const uint64 WindowBytesA = GetWindow(&A).Bytes;
+		const uint64 WindowBytesB = GetWindow(&B).Bytes;
+		return WindowBytesA != WindowBytesB ? WindowBytesA > WindowBytesB : A.Total.Bytes > B.Total.Bytes;
+	});
+
+	uint64 WindowBytes = 0;
+	uint64 TotalBytes = 0;
+	for (const FBandwidthEntry* Entry : SortedEntries)
+	{
+		WindowBytes += GetWindow(Entry).Bytes;
+		TotalBytes += Entry->Total.Bytes;
+	}
+
+	const float WindowDivisor = FMath::Max(WindowTime, KINDA_SMALL_NUMBER);
+
+	Ar.Logf(TEXT("%s: %.1f bytes/s, %llu bytes in total"), Title, WindowBytes / WindowDivisor, TotalBytes);
+	Ar.Logf(TEXT("  %12s %10s %14s %10s  %s"), TEXT("Bytes/s"), TEXT("Sends/s"), TEXT("Total bytes"), TEXT("Sends"), TEXT("Name"));
+
+	const int32 NumEntries = MaxEntries > 0 ? FMath::Min(MaxEntries, SortedEntries.Num()) : SortedEntries.Num();
+	for (int32 Index = 0; Index < NumEntries; Index++)
+	{
+		const FBandwidthEntry* Entry = SortedEntries[Index];
+		const FByteCount& Window = GetWindow(Entry);
+
+		Ar.Logf(TEXT("  %12.1f %10.1f %14llu %10u  %s"), Window.Bytes / WindowDivisor, Window.Count / WindowDivisor, Entry->Total.Bytes, Entry->Total.Count, *Entry->Name);
+	}
+}
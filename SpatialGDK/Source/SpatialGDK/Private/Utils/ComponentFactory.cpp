@@ -13,6 +13,10 @@
 #include "Schema/Interest.h"
 #include "SpatialConstants.h"
 #include "Utils/RepLayoutUtils.h"
+#include "Utils/SpatialNetStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("CreateComponentDatas"), STAT_SpatialComponentFactoryCreateComponentDatas, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("CreateComponentUpdates"), STAT_SpatialComponentFactoryCreateComponentUpdates, STATGROUP_SpatialNet);
 
 namespace improbable
 {
@@ -30,45 +34,47 @@ bool ComponentFactory::FillSchemaObject(Schema_Object* ComponentObject, UObject*
 {
 	bool bWroteSomething = false;
 
+	// Measuring the size of the object after every field is slow, so it's only done while profiling.
+	const bool bProfileBandwidth = NetDriver->BandwidthProfiler.IsRecording();
+
 	// Populate the replicated data component updates from the replicated property changelist.
-	if (Changes.RepChanged.Num() > 0)
+	for (TConstSetBitIterator<> It(Changes.RepChanged); It; ++It)
 	{
-		FChangelistIterator ChangelistIterator(Changes.RepChanged, 0);
-		FRepHandleIterator HandleIterator(ChangelistIterator, Changes.RepLayout.Cmds, Changes.RepLayout.BaseHandleToCmdIndex, 0, 1, 0, Changes.RepLayout.Cmds.Num() - 1);
-		while (HandleIterator.NextHandle())
+		const uint16 Handle = It.GetIndex() + 1;
+		const FRepLayoutCmd& Cmd = Changes.RepLayout.Cmds[Changes.RepLayout.BaseHandleToCmdIndex[It.GetIndex()].CmdIndex];
+		const FRepParentCmd& Parent = Changes.RepLayout.Parents[Cmd.ParentIndex];
+
+		if (GetGroupFromCondition(Parent.Condition) == PropertyGroup)
 		{
-			const FRepLayoutCmd& Cmd = Changes.RepLayout.Cmds[HandleIterator.CmdIndex];
-			const FRepParentCmd& Parent = Changes.RepLayout.Parents[Cmd.ParentIndex];
+			const uint8* Data = (uint8*)Object + Cmd.Offset;
+			TSet<TWeakObjectPtr<const UObject>> UnresolvedObjects;
 
-			if (GetGroupFromCondition(Parent.Condition) == PropertyGroup)
-			{
-				const uint8* Data = (uint8*)Object + Cmd.Offset;
-				TSet<TWeakObjectPtr<const UObject>> UnresolvedObjects;
+			const uint32 SizeBefore = bProfileBandwidth ? Schema_GetWriteBufferLength(ComponentObject) : 0;
 
-				AddProperty(ComponentObject, HandleIterator.Handle, Cmd.Property, Data, UnresolvedObjects, ClearedIds);
+			AddProperty(ComponentObject, Handle, Cmd.Property, Data, UnresolvedObjects, ClearedIds);
 
-				if (UnresolvedObjects.Num() == 0)
+			if (UnresolvedObjects.Num() == 0)
+			{
+				bWroteSomething = true;
+			}
+			else
+			{
+				if (!bIsInitialData)
 				{
-					bWroteSomething = true;
+					// Don't send updates for fields with unresolved objects, unless it's the initial data,
+					// in which case all fields should be populated.
+					Schema_ClearField(ComponentObject, Handle);
 				}
-				else
-				{
-					if (!bIsInitialData)
-					{
-						// Don't send updates for fields with unresolved objects, unless it's the initial data,
-						// in which case all fields should be populated.
-						Schema_ClearField(ComponentObject, HandleIterator.Handle);
-					}
 
-					PendingRepUnresolvedObjectsMap.Add(HandleIterator.Handle, UnresolvedObjects);
-				}
+				PendingRepUnresolvedObjectsMap.Add(Handle, UnresolvedObjects);
 			}
 
-			if (Cmd.Type == ERepLayoutCmdType::DynamicArray)
+			if (bProfileBandwidth)
 			{
-				if (!HandleIterator.JumpOverArray())
+				const uint32 SizeAfter = Schema_GetWriteBufferLength(ComponentObject);
+				if (SizeAfter > SizeBefore)
 				{
-					break;
+					NetDriver->BandwidthProfiler.RecordField(Object->GetClass(), PropertyGroup, Handle, Cmd.Property, SizeAfter - SizeBefore);
 				}
 			}
 		}
@@ -81,6 +87,8 @@ bool ComponentFactory::FillHandoverSchemaObject(Schema_Object* ComponentObject,
 {
 	bool bWroteSomething = false;
 
+	const bool bProfileBandwidth = NetDriver->BandwidthProfiler.IsRecording();
+
 	for (uint16 ChangedHandle : Changes)
 	{
 		check(ChangedHandle > 0 && ChangedHandle - 1 < Info.HandoverProperties.Num());
@@ -89,6 +97,8 @@ bool ComponentFactory::FillHandoverSchemaObject(Schema_Object* ComponentObject,
 		const uint8* Data = (uint8*)Object + PropertyInfo.Offset;
 		TSet<TWeakObjectPtr<const UObject>> UnresolvedObjects;
 
+		const uint32 SizeBefore = bProfileBandwidth ? Schema_GetWriteBufferLength(ComponentObject) : 0;
+
 		AddProperty(ComponentObject, ChangedHandle, PropertyInfo.Property, Data, UnresolvedObjects, ClearedIds);
 
 		if (UnresolvedObjects.Num() == 0)
@@ -106,6 +116,15 @@ bool ComponentFactory::FillHandoverSchemaObject(Schema_Object* ComponentObject,
 
 			PendingHandoverUnresolvedObjectsMap.Add(ChangedHandle, UnresolvedObjects);
 		}
+
+		if (bProfileBandwidth)
+		{
+			const uint32 SizeAfter = Schema_GetWriteBufferLength(ComponentObject);
+			if (SizeAfter > SizeBefore)
+			{
+				NetDriver->BandwidthProfiler.RecordField(Object->GetClass(), SCHEMA_Handover, ChangedHandle, PropertyInfo.Property, SizeAfter - SizeBefore);
+			}
+		}
 	}
 
 	return bWroteSomething;
@@ -244,9 +263,12 @@ void ComponentFactory::AddProperty(Schema_Object* Object, Schema_FieldId FieldId
 	else if (UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Property))
 	{
 		FScriptArrayHelper ArrayHelper(ArrayProperty, Data);
-		for (int i = 0; i < ArrayHelper.Num(); i++)
+		if (ArrayHelper.Num() > 0 && !AddPrimitiveList(Object, FieldId, GetSchemaFieldDecoder(ArrayProperty->Inner), ArrayHelper.GetRawPtr(), ArrayHelper.Num()))
 		{
-			AddProperty(Object, FieldId, ArrayProperty->Inner, ArrayHelper.GetRawPtr(i), UnresolvedObjects, ClearedIds);
+			for (int i = 0; i < ArrayHelper.Num(); i++)
+			{
+				AddProperty(Object, FieldId, ArrayProperty->Inner, ArrayHelper.GetRawPtr(i), UnresolvedObjects, ClearedIds);
+			}
 		}
 
 		if (ArrayHelper.Num() == 0 && ClearedIds)
@@ -277,6 +299,8 @@ void ComponentFactory::AddProperty(Schema_Object* Object, Schema_FieldId FieldId
 
 TArray<Worker_ComponentData> ComponentFactory::CreateComponentDatas(UObject* Object, const FClassInfo& Info, const FRepChangeState& RepChangeState, const FHandoverChangeState& HandoverChangeState)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialComponentFactoryCreateComponentDatas);
+
 	TArray<Worker_ComponentData> ComponentDatas;
 
 	if (Info.SchemaComponents[SCHEMA_Data] != SpatialConstants::INVALID_COMPONENT_ID)
@@ -303,6 +327,49 @@ TArray<Worker_ComponentData> ComponentFactory::CreateComponentDatas(UObject* Obj
 	return ComponentDatas;
 }
 
+bool ComponentFactory::AddPrimitiveList(Schema_Object* Object, Schema_FieldId FieldId, ESchemaFieldDecoder Decoder, const uint8* Data, uint32 Count)
+{
+	// Arrays of primitives are written as one list instead of one field per element.
+	switch (Decoder)
+	{
+	case ESchemaFieldDecoder::Bool:
+		AddListToSchema(Object, FieldId, &Schema_AddBoolList, reinterpret_cast<const bool*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::Float:
+		AddListToSchema(Object, FieldId, &Schema_AddFloatList, reinterpret_cast<const float*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::Double:
+		AddListToSchema(Object, FieldId, &Schema_AddDoubleList, reinterpret_cast<const double*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::Int8:
+		AddListToSchema(Object, FieldId, &Schema_AddInt32List, reinterpret_cast<const int8*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::Int16:
+		AddListToSchema(Object, FieldId, &Schema_AddInt32List, reinterpret_cast<const int16*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::Int32:
+		AddListToSchema(Object, FieldId, &Schema_AddInt32List, reinterpret_cast<const int32*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::Int64:
+		AddListToSchema(Object, FieldId, &Schema_AddInt64List, reinterpret_cast<const int64*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::UInt8:
+		AddListToSchema(Object, FieldId, &Schema_AddUint32List, reinterpret_cast<const uint8*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::UInt16:
+		AddListToSchema(Object, FieldId, &Schema_AddUint32List, reinterpret_cast<const uint16*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::UInt32:
+		AddListToSchema(Object, FieldId, &Schema_AddUint32List, reinterpret_cast<const uint32*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::UInt64:
+		AddListToSchema(Object, FieldId, &Schema_AddUint64List, reinterpret_cast<const uint64*>(Data), Count);
+		return true;
+	default:
+		return false;
+	}
+}
+
 Worker_ComponentData ComponentFactory::CreateComponentData(Worker_ComponentId ComponentId, UObject* Object, const FRepChangeState& Changes, ESchemaComponentType PropertyGroup)
 {
 	Worker_ComponentData ComponentData = {};
@@ -338,6 +405,8 @@ Worker_ComponentData ComponentFactory::CreateHandoverComponentData(Worker_Compon
 
 TArray<Worker_ComponentUpdate> ComponentFactory::CreateComponentUpdates(UObject* Object, const FClassInfo& Info, Worker_EntityId EntityId, const FRepChangeState* RepChangeState, const FHandoverChangeState* HandoverChangeState)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialComponentFactoryCreateComponentUpdates);
+
 	TArray<Worker_ComponentUpdate> ComponentUpdates;
 
 	if (RepChangeState)
@@ -12,9 +12,15 @@
 #include "SpatialConstants.h"
 #include "Utils/SchemaUtils.h"
 #include "Utils/RepLayoutUtils.h"
+#include "Utils/SpatialNetStats.h"
 
 DEFINE_LOG_CATEGORY(LogSpatialComponentReader);
 
+DECLARE_CYCLE_STAT(TEXT("Reader ApplyComponentData"), STAT_SpatialComponentReaderApplyComponentData, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("Reader ApplyComponentUpdates"), STAT_SpatialComponentReaderApplyComponentUpdates, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("Reader ApplySchemaObject"), STAT_SpatialComponentReaderApplySchemaObject, STATGROUP_SpatialNet);
+DECLARE_CYCLE_STAT(TEXT("Reader ApplyHandoverSchemaObject"), STAT_SpatialComponentReaderApplyHandoverSchemaObject, STATGROUP_SpatialNet);
+
 namespace improbable
 {
 
@@ -29,6 +35,8 @@ ComponentReader::ComponentReader(USpatialNetDriver* InNetDriver, FObjectReferenc
 
 void ComponentReader::ApplyComponentData(const Worker_ComponentData& ComponentData, UObject* Object, USpatialActorChannel* Channel, bool bIsHandover)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialComponentReaderApplyComponentData);
+
 	if (Object->IsPendingKill())
 	{
 		return;
@@ -85,8 +93,77 @@ void ComponentReader::ApplyComponentUpdate(const Worker_ComponentUpdate& Compone
 	}
 }
 
-void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArray<Schema_FieldId>& UpdatedIds)
+void ComponentReader::ApplyComponentUpdates(const TArray<const Worker_ComponentUpdate*>& ComponentUpdates, UObject* Object, USpatialActorChannel* Channel, bool bIsHandover)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialComponentReaderApplyComponentUpdates);
+
+	if (ComponentUpdates.Num() == 1)
+	{
+		ApplyComponentUpdate(*ComponentUpdates[0], Object, Channel, bIsHandover);
+		return;
+	}
+
+	if (Object->IsPendingKill())
+	{
+		return;
+	}
+
+	// Walk the updates from the latest, so each field is read from the last update that set or cleared it.
+	TArray<Schema_FieldId> UpdatedIds;
+	TArray<Schema_Object*> FieldObjects;
+	TArray<bool> SeenFieldIds;
+	TArray<Schema_FieldId> Ids;
+
+	for (int32 UpdateIndex = ComponentUpdates.Num() - 1; UpdateIndex >= 0; UpdateIndex--)
+	{
+		Schema_ComponentUpdate* SchemaUpdate = ComponentUpdates[UpdateIndex]->schema_type;
+		Schema_Object* ComponentObject = Schema_GetComponentUpdateFields(SchemaUpdate);
+
+		Ids.SetNumUninitialized(Schema_GetUniqueFieldIdCount(ComponentObject));
+		Schema_GetUniqueFieldIds(ComponentObject, Ids.GetData());
+
+		const int32 NumUpdatedIds = Ids.Num();
+		Ids.AddUninitialized(Schema_GetComponentUpdateClearedFieldCount(SchemaUpdate));
+		Schema_GetComponentUpdateClearedFieldList(SchemaUpdate, Ids.GetData() + NumUpdatedIds);
+
+		for (Schema_FieldId FieldId : Ids)
+		{
+			if ((int32)FieldId >= SeenFieldIds.Num())
+			{
+				SeenFieldIds.SetNumZeroed(FieldId + 1);
+			}
+
+			if (!SeenFieldIds[FieldId])
+			{
+				SeenFieldIds[FieldId] = true;
+				UpdatedIds.Add(FieldId);
+				FieldObjects.Add(ComponentObject);
+			}
+		}
+	}
+
+	if (UpdatedIds.Num() == 0)
+	{
+		return;
+	}
+
+	Schema_Object* LatestComponentObject = Schema_GetComponentUpdateFields(ComponentUpdates.Last()->schema_type);
+	if (bIsHandover)
+	{
+		ApplyHandoverSchemaObject(LatestComponentObject, Object, Channel, false, UpdatedIds, &FieldObjects);
+	}
+	else
+	{
+		ApplySchemaObject(LatestComponentObject, Object, Channel, false, UpdatedIds, &FieldObjects);
+	}
+}
+
+void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArray<Schema_FieldId>& UpdatedIds, const TArray<Schema_Object*>* FieldObjects)
+{
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialComponentReaderApplySchemaObject);
+
+	const FClassInfo& ClassInfo = ClassInfoManager->GetOrCreateClassInfoByClass(Object->GetClass());
+
 	FObjectReplicator& Replicator = Channel->PreReceiveSpatialUpdate(Object);
 
 	TSharedPtr<FRepState> RepState = Replicator.RepState;
@@ -100,13 +177,18 @@ void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject*
 
 	FSpatialConditionMapFilter ConditionMap(Channel, bIsClient);
 
-	TArray<UProperty*> RepNotifies;
+	// Indexed by parent cmd, so each RepNotify is only added once however many of its fields were updated.
+	TBitArray<> RepNotifies(false, Parents.Num());
 
-	for (uint32 FieldId : UpdatedIds)
+	for (int32 FieldIndex = 0; FieldIndex < UpdatedIds.Num(); FieldIndex++)
 	{
+		const Schema_FieldId FieldId = UpdatedIds[FieldIndex];
+		Schema_Object* FieldObject = FieldObjects != nullptr ? (*FieldObjects)[FieldIndex] : ComponentObject;
+
 		// FieldId is the same as rep handle
 		check(FieldId > 0 && (int)FieldId - 1 < BaseHandleToCmdIndex.Num());
-		const FRepLayoutCmd& Cmd = Cmds[BaseHandleToCmdIndex[FieldId - 1].CmdIndex];
+		const int32 CmdIndex = BaseHandleToCmdIndex[FieldId - 1].CmdIndex;
+		const FRepLayoutCmd& Cmd = Cmds[CmdIndex];
 		const FRepParentCmd& Parent = Parents[Cmd.ParentIndex];
 
 		if (NetDriver->IsServer() || ConditionMap.IsRelevant(Parent.Condition))
@@ -131,7 +213,7 @@ void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject*
 						// Populate array with existing data so compare will incorporate non-replicated entities
 						Cmd.Property->CopyCompleteValue((void*)&TempArray, Data);
 
-						ApplyArray(ComponentObject, FieldId, RootObjectReferencesMap, ArrayProperty, (uint8*)&TempArray, SwappedCmd.Offset, Cmd.ParentIndex);
+						ApplyArray(FieldObject, FieldId, RootObjectReferencesMap, ArrayProperty, (uint8*)&TempArray, SwappedCmd.Offset, Cmd.ParentIndex);
 						bProcessedArray = true;
 
 						if (!Cmd.Property->Identical((void*)&TempArray, Data))
@@ -152,12 +234,12 @@ void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject*
 
 				if (!bProcessedArray)
 				{
-					ApplyArray(ComponentObject, FieldId, RootObjectReferencesMap, ArrayProperty, Data, SwappedCmd.Offset, Cmd.ParentIndex);
+					ApplyArray(FieldObject, FieldId, RootObjectReferencesMap, ArrayProperty, Data, SwappedCmd.Offset, Cmd.ParentIndex);
 				}
 			}
 			else
 			{
-				ApplyProperty(ComponentObject, FieldId, RootObjectReferencesMap, 0, Cmd.Property, Data, SwappedCmd.Offset, Cmd.ParentIndex);
+				ApplyProperty(FieldObject, FieldId, RootObjectReferencesMap, 0, Cmd.Property, ClassInfo.RepCmdDecoders[CmdIndex], Data, SwappedCmd.Offset, Cmd.ParentIndex);
 			}
 
 			if (Cmd.Property->GetFName() == NAME_RemoteRole)
@@ -181,14 +263,14 @@ void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject*
 				{
 					if (!bIsIdentical)
 					{
-						RepNotifies.AddUnique(Parent.Property);
+						RepNotifies[Cmd.ParentIndex] = true;
 					}
 				}
 				else
 				{
 					if (Parent.RepNotifyCondition == REPNOTIFY_Always || !bIsIdentical)
 					{
-						RepNotifies.AddUnique(Parent.Property);
+						RepNotifies[Cmd.ParentIndex] = true;
 					}
 				}
 
@@ -201,102 +283,105 @@ void ComponentReader::ApplySchemaObject(Schema_Object* ComponentObject, UObject*
 	Channel->PostReceiveSpatialUpdate(Object, RepNotifies);
 }
 
-void ComponentReader::ApplyHandoverSchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArray<Schema_FieldId>& UpdatedIds)
+void ComponentReader::ApplyHandoverSchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArray<Schema_FieldId>& UpdatedIds, const TArray<Schema_Object*>* FieldObjects)
 {
+	SPATIALNET_SCOPE_CYCLE_COUNTER(STAT_SpatialComponentReaderApplyHandoverSchemaObject);
+
 	const FClassInfo& ClassInfo = ClassInfoManager->GetOrCreateClassInfoByClass(Object->GetClass());
 
 	Channel->PreReceiveSpatialUpdate(Object);
 
-	for (uint32 FieldId : UpdatedIds)
+	for (int32 FieldIndex = 0; FieldIndex < UpdatedIds.Num(); FieldIndex++)
 	{
+		const Schema_FieldId FieldId = UpdatedIds[FieldIndex];
+		Schema_Object* FieldObject = FieldObjects != nullptr ? (*FieldObjects)[FieldIndex] : ComponentObject;
+
 		// FieldId is the same as handover handle
 		check(FieldId > 0 && (int)FieldId - 1 < ClassInfo.HandoverProperties.Num());
 		const FHandoverPropertyInfo& PropertyInfo = ClassInfo.HandoverProperties[FieldId - 1];
 
 		uint8* Data = (uint8*)Object + PropertyInfo.Offset;
 
-		if (UArrayProperty* ArrayProperty = Cast<UArrayProperty>(PropertyInfo.Property))
+		if (PropertyInfo.Decoder == ESchemaFieldDecoder::Array)
 		{
-			ApplyArray(ComponentObject, FieldId, RootObjectReferencesMap, ArrayProperty, Data, PropertyInfo.Offset, -1);
+			ApplyArray(FieldObject, FieldId, RootObjectReferencesMap, static_cast<UArrayProperty*>(PropertyInfo.Property), Data, PropertyInfo.Offset, -1);
 		}
 		else
 		{
-			ApplyProperty(ComponentObject, FieldId, RootObjectReferencesMap, 0, PropertyInfo.Property, Data, PropertyInfo.Offset, -1);
+			ApplyProperty(FieldObject, FieldId, RootObjectReferencesMap, 0, PropertyInfo.Property, PropertyInfo.Decoder, Data, PropertyInfo.Offset, -1);
 		}
 	}
 
-	Channel->PostReceiveSpatialUpdate(Object, TArray<UProperty*>());
+	Channel->PostReceiveSpatialUpdate(Object, TBitArray<>());
 }
 
-void ComponentReader::ApplyProperty(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, uint32 Index, UProperty* Property, uint8* Data, int32 Offset, int32 ParentIndex)
+void ComponentReader::ApplyProperty(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, uint32 Index, UProperty* Property, ESchemaFieldDecoder Decoder, uint8* Data, int32 Offset, int32 ParentIndex)
 {
-	if (UStructProperty* StructProperty = Cast<UStructProperty>(Property))
+	// Primitives are written straight into the property memory, which has the layout of the C++ type of the decoder.
+	switch (Decoder)
 	{
-		TArray<uint8> ValueData = IndexBytesFromSchema(Object, FieldId, Index);
+	case ESchemaFieldDecoder::Struct:
+	{
+		// The bit reader copies the schema bytes into its own buffer, as FBitReader can't read from memory it doesn't own.
+		// The struct is then deserialized into the property memory, and the bytes are only kept if there are unresolved refs.
+		const uint8* ValueBytes = Schema_IndexBytes(Object, FieldId, Index);
+		const int32 ValueNumBytes = (int32)Schema_IndexBytesLength(Object, FieldId, Index);
 		// A bit hacky, we should probably include the number of bits with the data instead.
-		int64 CountBits = ValueData.Num() * 8;
+		int64 CountBits = ValueNumBytes * 8;
 		TSet<FUnrealObjectRef> NewUnresolvedRefs;
-		FSpatialNetBitReader ValueDataReader(PackageMap, ValueData.GetData(), CountBits, NewUnresolvedRefs);
+		FSpatialNetBitReader ValueDataReader(PackageMap, const_cast<uint8*>(ValueBytes), CountBits, NewUnresolvedRefs);
 		bool bHasUnmapped = false;
 
-		ReadStructProperty(ValueDataReader, StructProperty, NetDriver, Data, bHasUnmapped);
+		ReadStructProperty(ValueDataReader, static_cast<UStructProperty*>(Property), NetDriver, Data, bHasUnmapped);
 
 		if (bHasUnmapped)
 		{
-			InObjectReferencesMap.Add(Offset, FObjectReferences(ValueData, CountBits, NewUnresolvedRefs, ParentIndex, Property));
+			InObjectReferencesMap.Add(Offset, FObjectReferences(TArray<uint8>(ValueBytes, ValueNumBytes), CountBits, NewUnresolvedRefs, ParentIndex, Property));
 			UnresolvedRefs.Append(NewUnresolvedRefs);
 		}
 		else if (InObjectReferencesMap.Find(Offset))
 		{
 			InObjectReferencesMap.Remove(Offset);
 		}
-	}
-	else if (UBoolProperty* BoolProperty = Cast<UBoolProperty>(Property))
-	{
-		BoolProperty->SetPropertyValue(Data, Schema_IndexBool(Object, FieldId, Index) != 0);
-	}
-	else if (UFloatProperty* FloatProperty = Cast<UFloatProperty>(Property))
-	{
-		FloatProperty->SetPropertyValue(Data, Schema_IndexFloat(Object, FieldId, Index));
-	}
-	else if (UDoubleProperty* DoubleProperty = Cast<UDoubleProperty>(Property))
-	{
-		DoubleProperty->SetPropertyValue(Data, Schema_IndexDouble(Object, FieldId, Index));
-	}
-	else if (UInt8Property* Int8Property = Cast<UInt8Property>(Property))
-	{
-		Int8Property->SetPropertyValue(Data, (int8)Schema_IndexInt32(Object, FieldId, Index));
-	}
-	else if (UInt16Property* Int16Property = Cast<UInt16Property>(Property))
-	{
-		Int16Property->SetPropertyValue(Data, (int16)Schema_IndexInt32(Object, FieldId, Index));
-	}
-	else if (UIntProperty* IntProperty = Cast<UIntProperty>(Property))
-	{
-		IntProperty->SetPropertyValue(Data, Schema_IndexInt32(Object, FieldId, Index));
-	}
-	else if (UInt64Property* Int64Property = Cast<UInt64Property>(Property))
-	{
-		Int64Property->SetPropertyValue(Data, Schema_IndexInt64(Object, FieldId, Index));
-	}
-	else if (UByteProperty* ByteProperty = Cast<UByteProperty>(Property))
-	{
-		ByteProperty->SetPropertyValue(Data, (uint8)Schema_IndexUint32(Object, FieldId, Index));
-	}
-	else if (UUInt16Property* UInt16Property = Cast<UUInt16Property>(Property))
-	{
-		UInt16Property->SetPropertyValue(Data, (uint16)Schema_IndexUint32(Object, FieldId, Index));
-	}
-	else if (UUInt32Property* UInt32Property = Cast<UUInt32Property>(Property))
-	{
-		UInt32Property->SetPropertyValue(Data, Schema_IndexUint32(Object, FieldId, Index));
-	}
-	else if (UUInt64Property* UInt64Property = Cast<UUInt64Property>(Property))
-	{
-		UInt64Property->SetPropertyValue(Data, Schema_IndexUint64(Object, FieldId, Index));
-	}
-	else if (UObjectPropertyBase* ObjectProperty = Cast<UObjectPropertyBase>(Property))
-	{
+		break;
+	}
+	case ESchemaFieldDecoder::Bool:
+		// Bools can be bitfields, so they have to go through the property.
+		static_cast<UBoolProperty*>(Property)->SetPropertyValue(Data, Schema_IndexBool(Object, FieldId, Index) != 0);
+		break;
+	case ESchemaFieldDecoder::Float:
+		*reinterpret_cast<float*>(Data) = Schema_IndexFloat(Object, FieldId, Index);
+		break;
+	case ESchemaFieldDecoder::Double:
+		*reinterpret_cast<double*>(Data) = Schema_IndexDouble(Object, FieldId, Index);
+		break;
+	case ESchemaFieldDecoder::Int8:
+		*reinterpret_cast<int8*>(Data) = (int8)Schema_IndexInt32(Object, FieldId, Index);
+		break;
+	case ESchemaFieldDecoder::Int16:
+		*reinterpret_cast<int16*>(Data) = (int16)Schema_IndexInt32(Object, FieldId, Index);
+		break;
+	case ESchemaFieldDecoder::Int32:
+		*reinterpret_cast<int32*>(Data) = Schema_IndexInt32(Object, FieldId, Index);
+		break;
+	case ESchemaFieldDecoder::Int64:
+		*reinterpret_cast<int64*>(Data) = Schema_IndexInt64(Object, FieldId, Index);
+		break;
+	case ESchemaFieldDecoder::UInt8:
+		*reinterpret_cast<uint8*>(Data) = (uint8)Schema_IndexUint32(Object, FieldId, Index);
+		break;
+	case ESchemaFieldDecoder::UInt16:
+		*reinterpret_cast<uint16*>(Data) = (uint16)Schema_IndexUint32(Object, FieldId, Index);
+		break;
+	case ESchemaFieldDecoder::UInt32:
+		*reinterpret_cast<uint32*>(Data) = Schema_IndexUint32(Object, FieldId, Index);
+		break;
+	case ESchemaFieldDecoder::UInt64:
+		*reinterpret_cast<uint64*>(Data) = Schema_IndexUint64(Object, FieldId, Index);
+		break;
+	case ESchemaFieldDecoder::Object:
+	{
+		UObjectPropertyBase* ObjectProperty = static_cast<UObjectPropertyBase*>(Property);
 		FUnrealObjectRef ObjectRef = IndexObjectRefFromSchema(Object, FieldId, Index);
 		check(ObjectRef != FUnrealObjectRef::UNRESOLVED_OBJECT_REF);
 		bool bUnresolved = false;
@@ -337,33 +422,21 @@ void ComponentReader::ApplyProperty(Schema_Object* Object, Schema_FieldId FieldI
 		{
 			InObjectReferencesMap.Remove(Offset);
 		}
-	}
-	else if (UNameProperty* NameProperty = Cast<UNameProperty>(Property))
-	{
-		NameProperty->SetPropertyValue(Data, FName(*IndexStringFromSchema(Object, FieldId, Index)));
-	}
-	else if (UStrProperty* StrProperty = Cast<UStrProperty>(Property))
-	{
-		StrProperty->SetPropertyValue(Data, IndexStringFromSchema(Object, FieldId, Index));
-	}
-	else if (UTextProperty* TextProperty = Cast<UTextProperty>(Property))
-	{
-		TextProperty->SetPropertyValue(Data, FText::FromString(IndexStringFromSchema(Object, FieldId, Index)));
-	}
-	else if (UEnumProperty* EnumProperty = Cast<UEnumProperty>(Property))
-	{
-		if (EnumProperty->ElementSize < 4)
-		{
-			EnumProperty->GetUnderlyingProperty()->SetIntPropertyValue(Data, (uint64)Schema_IndexUint32(Object, FieldId, Index));
-		}
-		else
-		{
-			ApplyProperty(Object, FieldId, InObjectReferencesMap, Index, EnumProperty->GetUnderlyingProperty(), Data, Offset, ParentIndex);
-		}
-	}
-	else
-	{
+		break;
+	}
+	case ESchemaFieldDecoder::Name:
+		*reinterpret_cast<FName*>(Data) = FName(*IndexStringFromSchema(Object, FieldId, Index));
+		break;
+	case ESchemaFieldDecoder::String:
+		// Reuses the memory of the existing string.
+		IndexStringFromSchema(Object, FieldId, Index, *reinterpret_cast<FString*>(Data));
+		break;
+	case ESchemaFieldDecoder::Text:
+		static_cast<UTextProperty*>(Property)->SetPropertyValue(Data, FText::FromString(IndexStringFromSchema(Object, FieldId, Index)));
+		break;
+	default:
 		checkf(false, TEXT("Tried to read unknown property in field %d"), FieldId);
+		break;
 	}
 }
 
@@ -385,13 +458,19 @@ void ComponentReader::ApplyArray(Schema_Object* Object, Schema_FieldId FieldId,
 
 	FScriptArrayHelper ArrayHelper(Property, Data);
 
-	int Count = GetPropertyCount(Object, FieldId, Property->Inner);
+	// Resolve the decoder once for all the elements.
+	const ESchemaFieldDecoder InnerDecoder = GetSchemaFieldDecoder(Property->Inner);
+
+	int Count = GetPropertyCount(Object, FieldId, InnerDecoder);
 	ArrayHelper.Resize(Count);
 
-	for (int i = 0; i < Count; i++)
+	if (Count == 0 || !ApplyPrimitiveList(Object, FieldId, InnerDecoder, ArrayHelper.GetRawPtr(), Count))
 	{
-		int32 ElementOffset = i * Property->Inner->ElementSize;
-		ApplyProperty(Object, FieldId, *ArrayObjectReferences, i, Property->Inner, ArrayHelper.GetRawPtr(i), ElementOffset, ParentIndex);
+		for (int i = 0; i < Count; i++)
+		{
+			int32 ElementOffset = i * Property->Inner->ElementSize;
+			ApplyProperty(Object, FieldId, *ArrayObjectReferences, i, Property->Inner, InnerDecoder, ArrayHelper.GetRawPtr(i), ElementOffset, ParentIndex);
+		}
 	}
 
 	if (ArrayObjectReferences->Num() > 0)
@@ -415,89 +494,79 @@ void ComponentReader::ApplyArray(Schema_Object* Object, Schema_FieldId FieldId,
 	}
 }
 
-uint32 ComponentReader::GetPropertyCount(const Schema_Object* Object, Schema_FieldId FieldId, UProperty* Property)
+bool ComponentReader::ApplyPrimitiveList(Schema_Object* Object, Schema_FieldId FieldId, ESchemaFieldDecoder Decoder, uint8* Data, uint32 Count)
 {
-	if (UStructProperty* StructProperty = Cast<UStructProperty>(Property))
-	{
-		return Schema_GetBytesCount(Object, FieldId);
+	// Primitive elements can't hold object refs, so the whole list is read with one call instead of one per element.
+	switch (Decoder)
+	{
+	case ESchemaFieldDecoder::Bool:
+		GetListFromSchema(Object, FieldId, &Schema_GetBoolList, reinterpret_cast<bool*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::Float:
+		GetListFromSchema(Object, FieldId, &Schema_GetFloatList, reinterpret_cast<float*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::Double:
+		GetListFromSchema(Object, FieldId, &Schema_GetDoubleList, reinterpret_cast<double*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::Int8:
+		GetListFromSchema(Object, FieldId, &Schema_GetInt32List, reinterpret_cast<int8*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::Int16:
+		GetListFromSchema(Object, FieldId, &Schema_GetInt32List, reinterpret_cast<int16*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::Int32:
+		GetListFromSchema(Object, FieldId, &Schema_GetInt32List, reinterpret_cast<int32*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::Int64:
+		GetListFromSchema(Object, FieldId, &Schema_GetInt64List, reinterpret_cast<int64*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::UInt8:
+		GetListFromSchema(Object, FieldId, &Schema_GetUint32List, reinterpret_cast<uint8*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::UInt16:
+		GetListFromSchema(Object, FieldId, &Schema_GetUint32List, reinterpret_cast<uint16*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::UInt32:
+		GetListFromSchema(Object, FieldId, &Schema_GetUint32List, reinterpret_cast<uint32*>(Data), Count);
+		return true;
+	case ESchemaFieldDecoder::UInt64:
+		GetListFromSchema(Object, FieldId, &Schema_GetUint64List, reinterpret_cast<uint64*>(Data), Count);
+		return true;
+	default:
+		return false;
 	}
-	else if (UBoolProperty* BoolProperty = Cast<UBoolProperty>(Property))
+}
+
+uint32 ComponentReader::GetPropertyCount(const Schema_Object* Object, Schema_FieldId FieldId, ESchemaFieldDecoder Decoder)
+{
+	switch (Decoder)
 	{
+	case ESchemaFieldDecoder::Struct:
+	case ESchemaFieldDecoder::Name:
+	case ESchemaFieldDecoder::String:
+	case ESchemaFieldDecoder::Text:
+		return Schema_GetBytesCount(Object, FieldId);
+	case ESchemaFieldDecoder::Bool:
 		return Schema_GetBoolCount(Object, FieldId);
-	}
-	else if (UFloatProperty* FloatProperty = Cast<UFloatProperty>(Property))
-	{
+	case ESchemaFieldDecoder::Float:
 		return Schema_GetFloatCount(Object, FieldId);
-	}
-	else if (UDoubleProperty* DoubleProperty = Cast<UDoubleProperty>(Property))
-	{
+	case ESchemaFieldDecoder::Double:
 		return Schema_GetDoubleCount(Object, FieldId);
-	}
-	else if (UInt8Property* Int8Property = Cast<UInt8Property>(Property))
-	{
-		return Schema_GetInt32Count(Object, FieldId);
-	}
-	else if (UInt16Property* Int16Property = Cast<UInt16Property>(Property))
-	{
-		return Schema_GetInt32Count(Object, FieldId);
-	}
-	else if (UIntProperty* IntProperty = Cast<UIntProperty>(Property))
-	{
+	case ESchemaFieldDecoder::Int8:
+	case ESchemaFieldDecoder::Int16:
+	case ESchemaFieldDecoder::Int32:
 		return Schema_GetInt32Count(Object, FieldId);
-	}
-	else if (UInt64Property* Int64Property = Cast<UInt64Property>(Property))
-	{
+	case ESchemaFieldDecoder::Int64:
 		return Schema_GetInt64Count(Object, FieldId);
-	}
-	else if (UByteProperty* ByteProperty = Cast<UByteProperty>(Property))
-	{
-		return Schema_GetUint32Count(Object, FieldId);
-	}
-	else if (UUInt16Property* UInt16Property = Cast<UUInt16Property>(Property))
-	{
-		return Schema_GetUint32Count(Object, FieldId);
-	}
-	else if (UUInt32Property* UInt32Property = Cast<UUInt32Property>(Property))
-	{
+	case ESchemaFieldDecoder::UInt8:
+	case ESchemaFieldDecoder::UInt16:
+	case ESchemaFieldDecoder::UInt32:
 		return Schema_GetUint32Count(Object, FieldId);
-	}
-	else if (UUInt64Property* UInt64Property = Cast<UUInt64Property>(Property))
-	{
+	case ESchemaFieldDecoder::UInt64:
 		return Schema_GetUint64Count(Object, FieldId);
-	}
-	else if (UObjectPropertyBase* ObjectProperty = Cast<UObjectPropertyBase>(Property))
-	{
+	case ESchemaFieldDecoder::Object:
 		return Schema_GetObjectCount(Object, FieldId);
-	}
-	else if (UNameProperty* NameProperty = Cast<UNameProperty>(Property))
-	{
-		return Schema_GetBytesCount(Object, FieldId);
-	}
-	else if (UStrProperty* StrProperty = Cast<UStrProperty>(Property))
-	{
-		return Schema_GetBytesCount(Object, FieldId);
-	}
-	else if (UTextProperty* TextProperty = Cast<UTextProperty>(Property))
-	{
-		return Schema_GetBytesCount(Object, FieldId);
-	}
-	else if (UArrayProperty* ArrayProperty = Cast<UArrayProperty>(Property))
-	{
-		return GetPropertyCount(Object, FieldId, ArrayProperty->Inner);
-	}
-	else if (UEnumProperty* EnumProperty = Cast<UEnumProperty>(Property))
-	{
-		if (EnumProperty->ElementSize < 4)
-		{
-			return Schema_GetUint32Count(Object, FieldId);
-		}
-		else
-		{
-			return GetPropertyCount(Object, FieldId, EnumProperty->GetUnderlyingProperty());
-		}
-	}
-	else
-	{
+	default:
 		checkf(false, TEXT("Tried to get count of unknown property in field %d"), FieldId);
 		return 0;
 	}
@@ -0,0 +1,165 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/LatencyTracer.h"
+
+#include "Misc/DateTime.h"
+#include "Misc/OutputDevice.h"
+#include "UObject/Class.h"
+
+#include "SpatialConstants.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+
+DEFINE_LOG_CATEGORY(LogSpatialLatencyTracer);
+
+namespace
+{
+
+const TCHAR* const StageNames[] = { TEXT("Send"), TEXT("Runtime"), TEXT("Receive queue"), TEXT("Apply"), TEXT("Total") };
+
+}
+
+FLatencyTracer::FClassLatency::FClassLatency()
+	: NumClockSkewedTraces(0)
+	, MaxClockSkewUs(0)
+{
+	for (FTimeHistogram& Histogram : Stages)
+	{
+		Histogram = FTimeHistogram(1000.0);
+	}
+}
+
+FLatencyTracer::FLatencyTracer()
+	: NextTraceId(1)
+	, OpListReceivedTime(0)
+{
+}
+
+int64 FLatencyTracer::GetTimestampMicroseconds()
+{
+	return FDateTime::UtcNow().GetTicks() / ETimespan::TicksPerMicrosecond;
+}
+
+void FLatencyTracer::AddTrace(Worker_ComponentUpdate& Update, int64 SendStartTime)
+{
+	const int64 SendTime = GetTimestampMicroseconds();
+
+	Schema_Object* EventsObject = Schema_GetComponentUpdateEvents(Update.schema_type);
+	Schema_Object* TraceObject = Schema_AddObject(EventsObject, SpatialConstants::LATENCY_TRACE_EVENT_ID);
+	Schema_AddUint32(TraceObject, SpatialConstants::LATENCY_TRACE_ID_ID, NextTraceId++);
+	Schema_AddInt64(TraceObject, SpatialConstants::LATENCY_TRACE_SEND_TIME_ID, SendTime);
+	Schema_AddInt64(TraceObject, SpatialConstants::LATENCY_TRACE_SEND_DURATION_ID, SendTime - SendStartTime);
+}
+
+bool FLatencyTracer::HasTraces(const TArray<const Worker_ComponentUpdate*>& Updates)
+{
+	for (const Worker_ComponentUpdate* Update : Updates)
+	{
+		if (Schema_GetObjectCount(Schema_GetComponentUpdateEvents(Update->schema_type), SpatialConstants::LATENCY_TRACE_EVENT_ID) > 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void FLatencyTracer::OnOpListReceived()
+{
+	OpListReceivedTime = GetTimestampMicroseconds();
+}
+
+void FLatencyTracer::RecordTraces(const TArray<const Worker_ComponentUpdate*>& Updates, UClass* Class, int64 ApplyStartTime)
+{
+	const int64 ApplyEndTime = GetTimestampMicroseconds();
+
+	const FName ClassPath(*Class->GetPathName());
+	FClassLatency* ClassLatency = ClassLatencies.Find(ClassPath);
+	if (ClassLatency == nullptr)
+	{
+		ClassLatency = &ClassLatencies.Add(ClassPath);
+		ClassLatency->ClassName = Class->GetName();
+	}
+
+	// Updates applied together are merged, so all of them share the receiving side timings.
+	for (const Worker_ComponentUpdate* Update : Updates)
+	{
+		Schema_Object* EventsObject = Schema_GetComponentUpdateEvents(Update->schema_type);
+		const uint32 TraceCount = Schema_GetObjectCount(EventsObject, SpatialConstants::LATENCY_TRACE_EVENT_ID);
+
+		for (uint32 TraceIndex = 0; TraceIndex < TraceCount; TraceIndex++)
+		{
+			Schema_Object* TraceObject = Schema_IndexObject(EventsObject, SpatialConstants::LATENCY_TRACE_EVENT_ID, TraceIndex);
+			const uint32 TraceId = Schema_GetUint32(TraceObject, SpatialConstants::LATENCY_TRACE_ID_ID);
+			const int64 SendTime = Schema_GetInt64(TraceObject, SpatialConstants::LATENCY_TRACE_SEND_TIME_ID);
+
+			int64 StageTimes[Stage_Count];
+			StageTimes[Stage_Send] = Schema_GetInt64(TraceObject, SpatialConstants::LATENCY_TRACE_SEND_DURATION_ID);
+			StageTimes[Stage_Runtime] = OpListReceivedTime - SendTime;
+
+			// A negative runtime is clock skew between the workers, which would drag the averages below what was measured.
+			if (StageTimes[Stage_Runtime] < 0)
+			{
+				ClassLatency->NumClockSkewedTraces++;
+				ClassLatency->MaxClockSkewUs = FMath::Max(ClassLatency->MaxClockSkewUs, -StageTimes[Stage_Runtime]);
+				StageTimes[Stage_Runtime] = 0;
+			}
+
+			StageTimes[Stage_ReceiveQueue] = ApplyStartTime - OpListReceivedTime;
+			StageTimes[Stage_Apply] = ApplyEndTime - ApplyStartTime;
+			StageTimes[Stage_Total] = StageTimes[Stage_Send] + StageTimes[Stage_Runtime] + StageTimes[Stage_ReceiveQueue] + StageTimes[Stage_Apply];
+
+			for (int32 Stage = 0; Stage < Stage_Count; Stage++)
+			{
+				ClassLatency->Stages[Stage].AddSample(static_cast<double>(StageTimes[Stage]));
+			}
+
+			UE_LOG(LogSpatialLatencyTracer, Verbose, TEXT("Trace %u (component: %d, class: %s): send %lldus, runtime %lldus, receive queue %lldus, apply %lldus, total %lldus"),
+				TraceId, Update->component_id, *ClassLatency->ClassName, StageTimes[Stage_Send], StageTimes[Stage_Runtime], StageTimes[Stage_ReceiveQueue], StageTimes[Stage_Apply], StageTimes[Stage_Total]);
+		}
+	}
+}
+
+void FLatencyTracer::Dump(FOutputDevice& Ar) const
+{
+	TArray<const FClassLatency*> SortedLatencies;
+	for (const auto& Pair : ClassLatencies)
+	{
+		SortedLatencies.Add(&Pair.Value);
+	}
+
+	// Slowest classes first.
+	SortedLatencies.Sort([](const FClassLatency& A, const FClassLatency& B)
+	{
+		return A.Stages[Stage_Total].Sum * B.Stages[Stage_Total].NumSamples > B.Stages[Stage_Total].Sum * A.Stages[Stage_Total].NumSamples;
+	});
+
+	Ar.Logf(TEXT("Spatial latency traces received, in milliseconds (p50 and p95 are bucket upper bounds):"));
+
+	for (const FClassLatency* ClassLatency : SortedLatencies)
+	{
+		Ar.Logf(TEXT("%s: %u traces"), *ClassLatency->ClassName, ClassLatency->Stages[Stage_Total].NumSamples);
+		Ar.Logf(TEXT("  %-14s %9s %9s %9s %9s"), TEXT("Stage"), TEXT("Avg"), TEXT("p50"), TEXT("p95"), TEXT("Max"));
+
+		for (int32 Stage = 0; Stage < Stage_Count; Stage++)
+		{
+			const FTimeHistogram& Histogram = ClassLatency->Stages[Stage];
+			Ar.Logf(TEXT("  %-14s %9.2f %9.2f %9.2f %9.2f"), StageNames[Stage],
+				Histogram.Sum / 1000.0 / FMath::Max(Histogram.NumSamples, 1u),
+				Histogram.GetPercentileUpperBound(0.5f) / 1000.0,
+				Histogram.GetPercentileUpperBound(0.95f) / 1000.0,
+				Histogram.Max / 1000.0);
+		}
+
+		if (ClassLatency->NumClockSkewedTraces > 0)
+		{
+			Ar.Logf(TEXT("  %u traces had a negative runtime, recorded as 0 (max clock skew %.2fms)"),
+				ClassLatency->NumClockSkewedTraces, ClassLatency->MaxClockSkewUs / 1000.0);
+		}
+	}
+}
+
+void FLatencyTracer::Reset()
+{
+	ClassLatencies.Empty();
+}
@@ -0,0 +1,141 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/SpatialNetStats.h"
+
+#include "HAL/IConsoleManager.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+
+CSV_DEFINE_CATEGORY(SpatialNet, true);
+
+#define DECLARE_COMPONENT_BYTE_STATS(Category) \
+	DECLARE_DWORD_COUNTER_STAT(TEXT(#Category " Bytes Sent"), STAT_SpatialNet##Category##BytesSent, STATGROUP_SpatialNet); \
+	DECLARE_DWORD_COUNTER_STAT(TEXT(#Category " Bytes Received"), STAT_SpatialNet##Category##BytesReceived, STATGROUP_SpatialNet);
+
+DECLARE_COMPONENT_BYTE_STATS(Data)
+DECLARE_COMPONENT_BYTE_STATS(OwnerOnly)
+DECLARE_COMPONENT_BYTE_STATS(Handover)
+DECLARE_COMPONENT_BYTE_STATS(ClientRPC)
+DECLARE_COMPONENT_BYTE_STATS(ServerRPC)
+DECLARE_COMPONENT_BYTE_STATS(NetMulticastRPC)
+DECLARE_COMPONENT_BYTE_STATS(CrossServerRPC)
+
+#undef DECLARE_COMPONENT_BYTE_STATS
+
+static TAutoConsoleVariable<int32> CVarDetailedNetStats(
+	TEXT("Spatial.DetailedNetStats"),
+	0,
+	TEXT("If non-zero, collect the byte counts per component category and the per class replication timings in stat SpatialNet."));
+
+namespace improbable
+{
+
+namespace
+{
+
+void RecordComponentBytes(ESchemaComponentType Type, bool bSent, uint32 NumBytes)
+{
+#define RECORD_COMPONENT_BYTES(Category) \
+	if (bSent) \
+	{ \
+		INC_DWORD_STAT_BY(STAT_SpatialNet##Category##BytesSent, NumBytes); \
+		CSV_CUSTOM_STAT(SpatialNet, Category##BytesSent, (int32)NumBytes, ECsvCustomStatOp::Accumulate); \
+	} \
+	else \
+	{ \
+		INC_DWORD_STAT_BY(STAT_SpatialNet##Category##BytesReceived, NumBytes); \
+		CSV_CUSTOM_STAT(SpatialNet, Category##BytesReceived, (int32)NumBytes, ECsvCustomStatOp::Accumulate); \
+	}
+
+	switch (Type)
+	{
+	case SCHEMA_Data:
+		RECORD_COMPONENT_BYTES(Data);
+		break;
+	case SCHEMA_OwnerOnly:
+		RECORD_COMPONENT_BYTES(OwnerOnly);
+		break;
+	case SCHEMA_Handover:
+		RECORD_COMPONENT_BYTES(Handover);
+		break;
+	case SCHEMA_ClientRPC:
+		RECORD_COMPONENT_BYTES(ClientRPC);
+		break;
+	case SCHEMA_ServerRPC:
+		RECORD_COMPONENT_BYTES(ServerRPC);
+		break;
+	case SCHEMA_NetMulticastRPC:
+		RECORD_COMPONENT_BYTES(NetMulticastRPC);
+		break;
+	case SCHEMA_CrossServerRPC:
+		RECORD_COMPONENT_BYTES(CrossServerRPC);
+		break;
+	default:
+		break;
+	}
+
+#undef RECORD_COMPONENT_BYTES
+}
+
+}
+
+bool AreDetailedNetStatsEnabled()
+{
+	return CVarDetailedNetStats.GetValueOnAnyThread() != 0;
+}
+
+void RecordComponentUpdateBytes(ESchemaComponentType Type, bool bSent, const Worker_ComponentUpdate& Update)
+{
+	uint32 NumBytes = Schema_GetWriteBufferLength(Schema_GetComponentUpdateFields(Update.schema_type));
+	NumBytes += Schema_GetWriteBufferLength(Schema_GetComponentUpdateEvents(Update.schema_type));
+	RecordComponentBytes(Type, bSent, NumBytes);
+}
+
+void RecordCommandRequestBytes(ESchemaComponentType Type, bool bSent, const Worker_CommandRequest& Request)
+{
+	RecordComponentBytes(Type, bSent, Schema_GetWriteBufferLength(Schema_GetCommandRequestObject(Request.schema_type)));
+}
+
+#if STATS
+TStatId GetClassReplicationStatId(UClass* Class, bool bSent)
+{
+	check(IsInGameThread());
+
+	// Looked up by weak pointer first, which is cheap and can't match another class reusing the memory of a destroyed one.
+	// On a miss, the stat is found by class path, so a class which is loaded again or hot reloaded gets its old stat back and
+	// the path maps only grow with the number of distinct classes.
+	static TMap<TWeakObjectPtr<UClass>, TStatId> SentStatIdsByClass;
+	static TMap<TWeakObjectPtr<UClass>, TStatId> ReceivedStatIdsByClass;
+	static TMap<FName, TStatId> SentStatIdsByPath;
+	static TMap<FName, TStatId> ReceivedStatIdsByPath;
+
+	TMap<TWeakObjectPtr<UClass>, TStatId>& StatIdsByClass = bSent ? SentStatIdsByClass : ReceivedStatIdsByClass;
+	if (const TStatId* StatId = StatIdsByClass.Find(Class))
+	{
+		return *StatId;
+	}
+
+	const FName ClassPath(*Class->GetPathName());
+
+	TMap<FName, TStatId>& StatIdsByPath = bSent ? SentStatIdsByPath : ReceivedStatIdsByPath;
+	const TStatId* StatId = StatIdsByPath.Find(ClassPath);
+	if (StatId == nullptr)
+	{
+		const FString StatName = FString::Printf(TEXT("%s %s"), bSent ? TEXT("Replicate") : TEXT("Receive"), *Class->GetName());
+		StatId = &StatIdsByPath.Add(ClassPath, FDynamicStats::CreateStatId<FStatGroup_STATGROUP_SpatialNet>(StatName));
+	}
+
+	// Drop the entries of destroyed classes before adding, so the pointer map stays as small as the set of live classes.
+	for (auto It = StatIdsByClass.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	return StatIdsByClass.Add(Class, *StatId);
+}
+#endif
+
+}
@@ -0,0 +1,63 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#include "Utils/TimeHistogram.h"
+
+const double FTimeHistogram::BucketUpperBoundsMs[FTimeHistogram::NumBuckets - 1] =
+{
+	1.0, 2.0, 4.0, 8.0, 16.0, 33.0, 50.0, 100.0, 250.0
+};
+
+FTimeHistogram::FTimeHistogram(double InUnitsPerMs)
+	: UnitsPerMs(InUnitsPerMs)
+{
+	Reset();
+}
+
+void FTimeHistogram::AddSample(double Time)
+{
+	Sum += Time;
+	Max = NumSamples > 0 ? FMath::Max(Max, Time) : Time;
+	NumSamples++;
+
+	for (int32 Bucket = 0; Bucket < NumBuckets; Bucket++)
+	{
+		if (Time <= GetBucketUpperBound(Bucket))
+		{
+			BucketSamples[Bucket]++;
+			break;
+		}
+	}
+}
+
+void FTimeHistogram::Reset()
+{
+	Sum = 0.0;
+	Max = 0.0;
+	NumSamples = 0;
+	FMemory::Memzero(BucketSamples);
+}
+
+double FTimeHistogram::GetBucketUpperBound(int32 Bucket) const
+{
+	check(Bucket >= 0 && Bucket < NumBuckets);
+
+	return Bucket < NumBuckets - 1 ? BucketUpperBoundsMs[Bucket] * UnitsPerMs : TNumericLimits<double>::Max();
+}
+
+double FTimeHistogram::GetPercentileUpperBound(float Fraction) const
+{
+	const uint32 Threshold = FMath::CeilToInt(NumSamples * Fraction);
+
+	uint32 Samples = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets - 1; Bucket++)
+	{
+		Samples += BucketSamples[Bucket];
+		if (Samples >= Threshold)
+		{
+			return GetBucketUpperBound(Bucket);
+		}
+	}
+
+	// The last bucket has no upper bound, so the largest sample is the best estimate.
+	return Max;
+}
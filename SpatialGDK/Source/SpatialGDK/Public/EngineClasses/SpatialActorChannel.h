@@ -37,6 +37,12 @@ public:
 		EntityId = InEntityId;
 	}
 
+	// Class info of the channel actor, cached as an index into the class info table when the actor is set.
+	FORCEINLINE const FClassInfo& GetActorClassInfo() const
+	{
+		return NetDriver->ClassInfoManager->GetClassInfoByIndex(ActorClassIndex);
+	}
+
 	FORCEINLINE bool IsReadyForReplication() const
 	{
 		// Wait until we've reserved an entity ID.		
@@ -57,14 +63,14 @@ public:
 			return false;
 		}
 
-		const FClassInfo& Info = NetDriver->ClassInfoManager->GetOrCreateClassInfoByClass(Actor->GetClass());
+		const FClassInfo& Info = GetActorClassInfo();
 
 		return NetDriver->StaticComponentView->HasAuthority(EntityId, Info.SchemaComponents[SCHEMA_ClientRPC]);
 	}
 
 	FORCEINLINE bool IsOwnedByWorker() const
 	{
-		const FClassInfo& Info = NetDriver->ClassInfoManager->GetOrCreateClassInfoByClass(Actor->GetClass());
+		const FClassInfo& Info = GetActorClassInfo();
 
 		const TArray<FString>& WorkerAttributes = NetDriver->Connection->GetWorkerAttributes();
 		if (const WorkerRequirementSet* WorkerRequirementsSet = NetDriver->StaticComponentView->GetComponentData<improbable::EntityAcl>(EntityId)->ComponentWriteAcl.Find(Info.SchemaComponents[SCHEMA_ClientRPC]))
@@ -84,6 +90,17 @@ public:
 		return false;
 	}
 
+	// Whether this client left the multicast RPC components of the actor out of its interest, because the actor is out of range.
+	FORCEINLINE bool AreMulticastsCulled() const
+	{
+		return bMulticastsCulled;
+	}
+
+	FORCEINLINE void SetMulticastsCulled(bool bInMulticastsCulled)
+	{
+		bMulticastsCulled = bInMulticastsCulled;
+	}
+
 	FORCEINLINE bool IsAuthoritativeServer()
 	{
 		return NetDriver->IsServer() && NetDriver->StaticComponentView->HasAuthority(EntityId, SpatialConstants::POSITION_COMPONENT_ID);
@@ -108,30 +125,49 @@ public:
 	virtual void SetChannelActor(AActor* InActor) override;
 
 	void RegisterEntityId(const Worker_EntityId& ActorEntityId);
+
+	// Unbinds the actor from this channel, so that cleaning up the channel leaves the actor alive to be pooled.
+	void DetachActorForPooling();
 	bool ReplicateSubobject(UObject* Obj, const FClassInfo& Info, const FReplicationFlags& RepFlags);
 	virtual bool ReplicateSubobject(UObject* Obj, FOutBunch& Bunch, const FReplicationFlags& RepFlags) override;
 
 	TMap<UObject*, FClassInfo*> GetHandoverSubobjects();
 
+	// Compares the handover properties of the actor and its subobjects against their shadow data, and sends any that changed.
+	// Called by ReplicateActor every HandoverReplicationInterval, and right away when authority over the actor is about to move.
+	bool ReplicateHandover();
+
 	FRepChangeState CreateInitialRepChangeState(TWeakObjectPtr<UObject> Object);
 	FHandoverChangeState CreateInitialHandoverChangeState(const FClassInfo& ClassInfo);
 
-	// For an object that is replicated by this channel (i.e. this channel's actor or its component), find out whether a given handle is an array.
-	bool IsDynamicArrayHandle(UObject* Object, uint16 Handle);
-
 	void SpatialViewTick();
 	FObjectReplicator& PreReceiveSpatialUpdate(UObject* TargetObject);
-	void PostReceiveSpatialUpdate(UObject* TargetObject, const TArray<UProperty*>& RepNotifies);
+	// RepNotifies is a bitset of rep layout parent indices. The RepNotifies aren't called right away, but collected per object
+	// until FlushRepNotifies, so an object receiving several updates in one tick calls each of its RepNotifies only once.
+	void PostReceiveSpatialUpdate(UObject* TargetObject, const TBitArray<>& RepNotifies);
+	void FlushRepNotifies();
 
 	void OnReserveEntityIdResponse(const struct Worker_ReserveEntityIdResponseOp& Op);
 	void OnCreateEntityResponse(const struct Worker_CreateEntityResponseOp& Op);
 
 	FVector GetActorSpatialPosition(AActor* Actor);
 
-	void RemoveRepNotifiesWithUnresolvedObjs(TArray<UProperty*>& RepNotifies, const FRepLayout& RepLayout, const FObjectReferencesMap& RefMap, UObject* Object);
+	void RemoveRepNotifiesWithUnresolvedObjs(TBitArray<>& RepNotifies, const FRepLayout& RepLayout, const FObjectReferencesMap& RefMap, UObject* Object);
 	
 	void UpdateShadowData();
 
+	// Unreliable RPCs sent as events are numbered per RPC component, so the receiver can drop the ones which arrive late.
+	uint32 GetNextUnreliableRPCSequence(Worker_ComponentId ComponentId);
+	// Returns false if the RPC with the given sequence is older than the last one received on the component.
+	bool OnReceivedUnreliableRPC(Worker_ComponentId ComponentId, uint32 Sequence);
+
+#if !UE_BUILD_SHIPPING
+	// Reliable RPCs are numbered per RPC type of the channel actor, so the receiver can detect if they arrive out of order.
+	uint32 GetNextReliableRPCId(ESchemaComponentType RPCType);
+	void OnReceivedReliableRPC(ESchemaComponentType RPCType, FName WorkerId, uint32 RPCId, UObject* TargetObject, UFunction* Function);
+	void OnRPCAuthorityGained(ESchemaComponentType RPCType);
+#endif // !UE_BUILD_SHIPPING
+
 protected:
 	// UChannel Interface
 	virtual bool CleanUp(const bool bForDestroy) override;
@@ -143,13 +179,17 @@ private:
 
 	void UpdateSpatialPosition();
 
+	bool ShouldReplicateHandover() const;
+
 	void InitializeHandoverShadowData(TArray<uint8>& ShadowData, UObject* Object);
 	FHandoverChangeState GetHandoverChangeList(TArray<uint8>& ShadowData, UObject* Object);
 
 private:
 	Worker_EntityId EntityId;
+	int32 ActorClassIndex;
 	bool bFirstTick;
 	bool bNetOwned;
+	bool bMulticastsCulled;
 
 	UPROPERTY(transient)
 	USpatialNetDriver* NetDriver;
@@ -169,6 +209,32 @@ private:
 	TArray<uint8>* ActorHandoverShadowData;
 	TMap<TWeakObjectPtr<UObject>, TSharedRef<TArray<uint8>>> HandoverShadowDataMap;
 
+	// RepNotifies waiting for FlushRepNotifies, per object. While an object has an entry, its rep state shadow data isn't
+	// refreshed on new updates, so the RepNotifies get the values from before the first of the coalesced updates.
+	TMap<TWeakObjectPtr<UObject>, TBitArray<>> PendingRepNotifies;
+
 	// If this actor channel is responsible for creating a new entity, this will be set to true during initial replication.
 	bool bCreatingNewEntity;
+
+	// Net driver time after which ReplicateActor next compares the handover properties.
+	float NextHandoverReplicationTime;
+
+	// Sequence of the next unreliable RPC event sent, and of the last one received, per RPC component.
+	TMap<Worker_ComponentId, uint32> OutgoingUnreliableRPCSequences;
+	TMap<Worker_ComponentId, uint32> IncomingUnreliableRPCSequences;
+
+#if !UE_BUILD_SHIPPING
+	struct FReliableRPCId
+	{
+		// The worker we receive RPCs of this type from, or none if we send them.
+		FName WorkerId;
+		uint32 RPCId = 0;
+		// The last RPC received, only looked up by name when logging a problem.
+		TWeakObjectPtr<UObject> LastRPCTarget;
+		uint32 LastRPCIndex = 0;
+	};
+
+	// Indexed by RPC type - SCHEMA_FirstRPC. An entry with no worker and an RPCId of 0 hasn't sent or received any RPCs.
+	FReliableRPCId ReliableRPCIds[SCHEMA_LastRPC - SCHEMA_FirstRPC + 1];
+#endif // !UE_BUILD_SHIPPING
 };
@@ -11,6 +11,9 @@
 #include "Interop/Connection/ConnectionConfig.h"
 #include "Interop/SpatialOutputDevice.h"
 #include "SpatialConstants.h"
+#include "Utils/BandwidthProfiler.h"
+#include "Utils/LatencyTracer.h"
+#include "Utils/SpatialNetStats.h"
 
 #include <WorkerSDK/improbable/c_worker.h>
 
@@ -29,12 +32,13 @@ class UGlobalStateManager;
 class USpatialPlayerSpawner;
 class USpatialStaticComponentView;
 class USnapshotManager;
+class USpatialMetrics;
 
+class UActorPool;
 class UEntityRegistry;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogSpatialOSNetDriver, Log, All);
 
-DECLARE_STATS_GROUP(TEXT("SpatialNet"), STATGROUP_SpatialNet, STATCAT_Advanced);
 DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Consider List Size"), STAT_SpatialConsiderList, STATGROUP_SpatialNet,);
 
 UCLASS()
@@ -55,10 +59,13 @@ public:
 	virtual void TickFlush(float DeltaTime) override;
 	virtual bool IsLevelInitializedForActor(const AActor* InActor, const UNetConnection* InConnection) const override;
 	virtual void NotifyActorDestroyed(AActor* Actor, bool IsSeamlessTravel = false) override;
+	virtual void Shutdown() override;
 	// End UNetDriver interface.
 
 #if !UE_BUILD_SHIPPING
 	bool HandleNetDumpCrossServerRPCCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleSpatialBandwidthCommand(const TCHAR* Cmd, FOutputDevice& Ar);
+	bool HandleSpatialLatencyCommand(const TCHAR* Cmd, FOutputDevice& Ar);
 #endif
 
 	// Returns the "100% reliable" connection to SpatialOS.
@@ -106,7 +113,11 @@ public:
 	UPROPERTY()
 	UEntityRegistry* EntityRegistry;
 	UPROPERTY()
+	UActorPool* ActorPool;
+	UPROPERTY()
 	USnapshotManager* SnapshotManager;
+	UPROPERTY()
+	USpatialMetrics* SpatialMetrics;
 
 	// Limit the number of actors which are replicated per tick to the number specified.
 	// This acts as a hard limit to the number of actors per frame but nothing else. It's recommended to set this value to around 100~ (experimentation recommended).
@@ -115,31 +126,74 @@ public:
 	UPROPERTY(Config)
 	int32 ActorReplicationRateLimit;
 
+	// Build the class info of every class in the SchemaDatabase when the net driver starts, instead of lazily on first use.
+	// This loads all of those classes up front, which lengthens startup but removes hitches the first time a class is replicated.
+	UPROPERTY(Config)
+	bool bPrecomputeClassInfos;
+
+	// Spread the spawning of checked out actors over several frames, spending at most this many milliseconds per frame on it.
+	// Entities closest to the local viewers are spawned first. If not set, every entity is spawned as soon as it's checked out,
+	// which can freeze clients for a long time when entering a dense area.
+	UPROPERTY(Config)
+	float EntityCheckoutBudgetMs;
+
+	// Actors of these classes (and their subclasses) are kept in a pool when their entity leaves the client's interest, and reused
+	// for the next entity of the same class instead of spawning a new actor. Only worth it for classes which are checked out and removed
+	// very often, such as projectiles or pickups. Pooled actors have AActor::Reset called on them and don't receive BeginPlay again.
+	UPROPERTY(Config)
+	TArray<FSoftClassPath> PooledActorClasses;
+
+	// The maximum number of actors kept in the pool for each class in PooledActorClasses. No actors are pooled if this isn't set.
+	UPROPERTY(Config)
+	int32 MaxPooledActorsPerClass;
+
+	// Only compare and send handover properties at this interval in seconds, and right before authority over an actor is lost.
+	// Handover data is only read by the worker which gains authority, so it doesn't need to be as fresh as replicated data.
+	// This relies on the loss imminent notification being enabled for the entities' Position component; without it handover
+	// data can be up to one interval stale. If not set, handover properties are compared every time an actor replicates.
+	UPROPERTY(Config)
+	float HandoverReplicationInterval;
+
+	// Report GDK metrics (frame time, op processing and replication times, queue sizes) to SpatialOS at this interval in seconds,
+	// where they can be compared per worker. The values are also shown in `stat SpatialNet`. If not set, no metrics are reported.
+	UPROPERTY(Config)
+	float MetricsReportInterval;
+
+	// The fraction of outgoing data and handover component updates which carry a latency trace, between 0 and 1. The latency
+	// of traced updates is recorded per class by the receiving worker, see FLatencyTracer. If not set, no updates are traced.
+	UPROPERTY(Config)
+	float LatencyTraceSampleRate;
+
+	// Send unreliable client and server RPCs as events on an RPC component update instead of as commands, so they don't need a
+	// response. Reliable and CrossServer RPCs are always sent as commands.
+	UPROPERTY(Config)
+	bool bSendUnreliableRPCsAsEvents;
+
+	// Send reliable client and server RPCs through a ring buffer on the ClientRPCEndpoint and ServerRPCEndpoint components of the
+	// entity instead of as commands. The receiver acknowledges them on its own endpoint, so there are no command responses or
+	// retries, and the RPCs of an entity arrive in the order they were sent. RPCs which don't fit in the buffer wait for an
+	// acknowledgement. Entities created while this is off don't have the endpoints, and their RPCs are still sent as commands.
+	UPROPERTY(Config)
+	bool bUseRPCRingBuffers;
+
+	// On clients, check at this interval in seconds which actors are outside the net cull distance of every local viewer, and remove
+	// interest in their multicast RPC components so unreliable multicasts on them are no longer received. Classes with reliable
+	// multicast RPCs are never culled, as those RPCs must arrive. If not set, clients receive the multicasts of every checked out actor.
+	UPROPERTY(Config)
+	float MulticastRelevancyUpdateInterval;
+
 	TMap<UClass*, TPair<AActor*, USpatialActorChannel*>> SingletonActorChannels;
 
+	// Outgoing bandwidth per property and RPC, only recorded after `SPATIALBANDWIDTH START`.
+	FBandwidthProfiler BandwidthProfiler;
+
+	// Latency of the traced updates received by this worker, shown with `SPATIALLATENCY DUMP`.
+	FLatencyTracer LatencyTracer;
+
 	bool IsAuthoritativeDestructionAllowed() const { return bAuthoritativeDestruction; }
 	void StartIgnoringAuthoritativeDestruction() { bAuthoritativeDestruction = false; }
 	void StopIgnoringAuthoritativeDestruction() { bAuthoritativeDestruction = true; }
 
-#if !UE_BUILD_SHIPPING
-	uint32 GetNextReliableRPCId(AActor* Actor, ESchemaComponentType RPCType, UObject* TargetObject);
-	void OnReceivedReliableRPC(AActor* Actor, ESchemaComponentType RPCType, FString WorkerId, uint32 RPCId, UObject* TargetObject, UFunction* Function);
-	void OnRPCAuthorityGained(AActor* Actor, ESchemaComponentType RPCType);
-
-	struct FReliableRPCId
-	{
-		FReliableRPCId() = default;
-		FReliableRPCId(FString InWorkerId, uint32 InRPCId, FString InRPCTarget, FString InRPCName) : WorkerId(InWorkerId), RPCId(InRPCId), LastRPCTarget(InRPCTarget), LastRPCName(InRPCName) {}
-
-		FString WorkerId;
-		uint32 RPCId = 0;
-		FString LastRPCTarget;
-		FString LastRPCName;
-	};
-	using FRPCTypeToReliableRPCIdMap = TMap<ESchemaComponentType, FReliableRPCId>;
-	// Per actor, maps from RPC type to the reliable RPC index used to detect if reliable RPCs go out of order.
-	TMap<TWeakObjectPtr<AActor>, FRPCTypeToReliableRPCIdMap> ReliableRPCIdMap;
-#endif // !UE_BUILD_SHIPPING
 
 	void DelayedSendDeleteEntityRequest(Worker_EntityId EntityId, float Delay);
 
@@ -160,6 +214,9 @@ private:
 	UFUNCTION()
 	void OnMapLoaded(UWorld* LoadedWorld);
 
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+	FDelegateHandle OnWorldCleanupHandle;
+
 	void Connect();
 
 	UFUNCTION()
@@ -170,6 +227,10 @@ private:
 
 	static void SpatialProcessServerTravel(const FString& URL, bool bAbsolute, AGameModeBase* GameMode);
 
+	void UpdateMulticastRelevancy();
+
+	float NextMulticastRelevancyUpdateTime;
+
 #if WITH_SERVER_CODE
 	// SpatialGDK: These functions all exist in UNetDriver, but we need to modify/simplify them in certain ways.
 	// Could have marked them virtual in base class but that's a pointless source change as these functions are not meant to be called from anywhere except USpatialNetDriver::ServerReplicateActors.
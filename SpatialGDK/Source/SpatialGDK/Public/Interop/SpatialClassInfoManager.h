@@ -35,12 +35,57 @@ struct FRPCInfo
 	uint32 Index;
 };
 
+// How the value of a property is read from its schema field. Resolved once per property when its class info is created, so
+// the component reader can switch on it instead of casting the property to each property class in turn.
+enum class ESchemaFieldDecoder : uint8
+{
+	Unknown,
+	Struct,
+	Bool,
+	Float,
+	Double,
+	Int8,
+	Int16,
+	Int32,
+	Int64,
+	UInt8,
+	UInt16,
+	UInt32,
+	UInt64,
+	Object,
+	Name,
+	String,
+	Text,
+	Array
+};
+
+// Enums are resolved to the decoder of the integer they are stored as.
+SPATIALGDK_API ESchemaFieldDecoder GetSchemaFieldDecoder(UProperty* Property);
+
 struct FHandoverPropertyInfo
 {
 	uint16 Handle;
 	int32 Offset;
 	int32 ArrayIdx;
 	UProperty* Property;
+	ESchemaFieldDecoder Decoder;
+	// Offset of this property's value in the handover shadow data of an object (see USpatialActorChannel::GetHandoverChangeList).
+	int32 ShadowOffset;
+	// Plain old data properties are compared and copied bytewise instead of through the virtual UProperty functions.
+	bool bIsPlainOldData;
+};
+
+// A range of handover properties which are compared against the shadow data together. Consecutive plain old data properties
+// which are back to back in the object are merged into one run and laid out the same way in the shadow data, so an unchanged
+// run costs a single memcmp. Every other property is a run of its own.
+struct FHandoverShadowRun
+{
+	int32 Offset;
+	int32 ShadowOffset;
+	int32 Size;
+	int32 FirstProperty;
+	int32 NumProperties;
+	bool bIsPlainOldData;
 };
 
 struct FInterestPropertyInfo
@@ -58,8 +103,13 @@ struct FClassInfo
 
 	TMap<ESchemaComponentType, TArray<UFunction*>> RPCs;
 	TMap<UFunction*, FRPCInfo> RPCInfoMap;
+	bool bHasReliableMulticastRPCs = false;
 
 	TArray<FHandoverPropertyInfo> HandoverProperties;
+	TArray<FHandoverShadowRun> HandoverShadowRuns;
+	int32 HandoverShadowSize = 0;
+	// The decoder of each cmd in the class' FRepLayout, indexed by cmd index.
+	TArray<ESchemaFieldDecoder> RepCmdDecoders;
 	TArray<FInterestPropertyInfo> InterestProperties;
 
 	Worker_ComponentId SchemaComponents[ESchemaComponentType::SCHEMA_Count] = {};
@@ -67,8 +117,18 @@ struct FClassInfo
 	FName SubobjectName;
 
 	TMap<uint32, TSharedRef<FClassInfo>> SubobjectInfo;
+
+	// Index of this class in the USpatialClassInfoManager class info table.
+	int32 ClassIndex = INDEX_NONE;
 };
 
+// Whether a client can stop receiving the multicast RPCs of the class when it's out of range, see
+// USpatialNetDriver::MulticastRelevancyUpdateInterval. Reliable multicasts must not be lost, so classes with any are never culled.
+FORCEINLINE bool CanCullMulticastRPCs(const FClassInfo& Info)
+{
+	return Info.SchemaComponents[SCHEMA_NetMulticastRPC] != SpatialConstants::INVALID_COMPONENT_ID && !Info.bHasReliableMulticastRPCs;
+}
+
 class USpatialNetDriver;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogSpatialClassInfoManager, Log, All)
@@ -89,13 +149,48 @@ public:
 	const FClassInfo& GetOrCreateClassInfoByObject(UObject* Object);
 	const FClassInfo& GetClassInfoByComponentId(Worker_ComponentId ComponentId) const;
 
+	// Returns the class info stored at FClassInfo::ClassIndex. Entries are only ever appended, on the game thread, so an index
+	// stays valid even after its class has been replaced by hot reload.
+	FORCEINLINE const FClassInfo& GetClassInfoByIndex(int32 ClassIndex) const
+	{
+		checkf(ClassInfoTable.IsValidIndex(ClassIndex), TEXT("Invalid class info index %d"), ClassIndex);
+		return ClassInfoTable[ClassIndex].Get();
+	}
+
 	UClass* GetClassByComponentId(Worker_ComponentId ComponentId);
+
+	// Resolves the class path stored in an entity's UnrealMetadata to its actor class, or nullptr if it isn't a loaded actor class.
+	// Resolved classes are cached, so only the first entity of each class has to search for the class object.
+	UClass* GetActorClassByPath(const FString& ClassPath);
 	bool GetOffsetByComponentId(Worker_ComponentId ComponentId, uint32& OutOffset);
 	ESchemaComponentType GetCategoryByComponentId(Worker_ComponentId ComponentId);
 
 private:
 	void CreateClassInfoForClass(UClass* Class);
 
+	// Builds the class info of every class in the SchemaDatabase which can be loaded. Classes loaded later, or re-created by
+	// hot reload, still get their class info lazily.
+	void PrecomputeClassInfos();
+
+#if WITH_EDITOR
+	void OnObjectsReplaced(const TMap<UObject*, UObject*>& OldToNewInstanceMap);
+#endif
+
+	static void FillClassInfoFromReflection(FClassInfo& Info, UClass* Class);
+	static void BuildHandoverShadowLayout(FClassInfo& Info);
+	void RegisterClassInfo(TSharedRef<FClassInfo> Info);
+	void CreateSubobjectInfos(FClassInfo& Info);
+
+	// The class info and subobject offset a generated component id belongs to.
+	struct FComponentSlot
+	{
+		TSharedPtr<FClassInfo> Info;
+		uint32 Offset = 0;
+	};
+
+	void AddComponentId(Worker_ComponentId ComponentId, ESchemaComponentType Type, TSharedRef<FClassInfo> Info, uint32 Offset);
+	const FComponentSlot* FindComponentSlot(Worker_ComponentId ComponentId, ESchemaComponentType& OutType) const;
+
 private:
 	UPROPERTY()
 	USpatialNetDriver* NetDriver;
@@ -103,9 +198,25 @@ private:
 	UPROPERTY()
 	USchemaDatabase* SchemaDatabase;
 
+	// Keeps precomputed classes loaded, so their class info doesn't go stale unless they are replaced by hot reload.
+	UPROPERTY()
+	TArray<UClass*> PrecomputedClasses;
+
 	TMap<TWeakObjectPtr<UClass>, TSharedRef<FClassInfo>> ClassInfoMap;
 
-	TMap<Worker_ComponentId, TSharedRef<FClassInfo>> ComponentToClassInfoMap;
-	TMap<Worker_ComponentId, uint32> ComponentToOffsetMap;
-	TMap<Worker_ComponentId, ESchemaComponentType> ComponentToCategoryMap;
+	// Every class info created so far, indexed by FClassInfo::ClassIndex.
+	TArray<TSharedRef<FClassInfo>> ClassInfoTable;
+	bool bClassInfosPrecomputed = false;
+
+	// With packed component ids, every actor and subobject owns a slot of SCHEMA_Count ids, so the slot of a component id is
+	// (ComponentId - STARTING_GENERATED_COMPONENT_ID) / SCHEMA_Count and its type is the remainder.
+	bool bPackedComponentIds = false;
+	TArray<FComponentSlot> ComponentSlots;
+
+	// Used instead of ComponentSlots when the SchemaDatabase was generated before component ids were packed.
+	TMap<Worker_ComponentId, TPair<FComponentSlot, ESchemaComponentType>> UnpackedComponentIds;
+
+	// Weak, so classes which are unloaded drop out of the cache. In the editor, the cache is also cleared when classes are
+	// reinstanced by a hot reload or blueprint compile, as the old class objects stay alive for a while.
+	TMap<FString, TWeakObjectPtr<UClass>> ClassPathToActorClass;
 };
@@ -20,6 +20,20 @@ class USpatialNetDriver;
 class USpatialReceiver;
 class USpatialStaticComponentView;
 
+// A component update op, chained to the next update of the same entity component in the op list being processed.
+struct FQueuedComponentUpdate
+{
+	Worker_ComponentUpdateOp* Op;
+	int32 NextIndex;
+};
+
+// First and last index in USpatialDispatcher::QueuedComponentUpdates of the updates received for one entity component.
+struct FQueuedComponentUpdateList
+{
+	int32 First;
+	int32 Last;
+};
+
 UCLASS()
 class SPATIALGDK_API USpatialDispatcher : public UObject
 {
@@ -30,6 +44,10 @@ public:
 	void ProcessOps(Worker_OpList* OpList);
 
 private:
+	void ReserveCriticalSection(const Worker_OpList* OpList, size_t FirstOpIndex);
+	void QueueComponentUpdate(Worker_ComponentUpdateOp* Op);
+	void ProcessQueuedComponentUpdates();
+
 	UPROPERTY()
 	USpatialNetDriver* NetDriver;
 
@@ -38,4 +56,11 @@ private:
 
 	UPROPERTY()
 	USpatialStaticComponentView* StaticComponentView;
+
+	// Component updates of the op list being processed, grouped per entity component in the order each was first updated.
+	// They're reset after every op list but keep their memory.
+	TArray<FQueuedComponentUpdate> QueuedComponentUpdates;
+	TMap<TPair<Worker_EntityId_Key, Worker_ComponentId>, int32> QueuedComponentUpdateListIndices;
+	TArray<FQueuedComponentUpdateList> QueuedComponentUpdateLists;
+	TArray<const Worker_ComponentUpdate*> MergedComponentUpdates;
 };
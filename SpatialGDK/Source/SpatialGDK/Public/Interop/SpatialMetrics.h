@@ -0,0 +1,48 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Utils/TimeHistogram.h"
+
+#include "SpatialMetrics.generated.h"
+
+class USpatialNetDriver;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSpatialMetrics, Log, All)
+
+// Collects the timings and queue sizes of the GDK on this worker, and reports them to SpatialOS as worker metrics every
+// USpatialNetDriver::MetricsReportInterval seconds, so the load of each worker can be compared in the deployment's dashboards.
+// The last reported values can also be seen locally with `stat SpatialNet`.
+UCLASS()
+class SPATIALGDK_API USpatialMetrics : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	void Init(USpatialNetDriver* InNetDriver);
+
+	// Called once per net driver tick. Reports the metrics collected so far when the report interval has passed.
+	void TickMetrics(float DeltaTime);
+
+	void OnOpsProcessed(uint32 OpCount, double ProcessOpsMs);
+	void OnServerReplicateActors(int32 ActorsReplicated, double ReplicateActorsMs);
+
+private:
+	void ReportMetrics();
+
+	UPROPERTY()
+	USpatialNetDriver* NetDriver;
+
+	float TimeSinceLastReport;
+	uint32 NumTicks;
+	uint64 NumOpsReceived;
+	uint64 NumActorsReplicated;
+	uint32 LastNumRetriedRPCs;
+
+	// Millisecond histograms, sent as Worker_HistogramMetrics and reset on every report.
+	FTimeHistogram FrameTime;
+	FTimeHistogram ProcessOpsTime;
+	FTimeHistogram ReplicateActorsTime;
+};
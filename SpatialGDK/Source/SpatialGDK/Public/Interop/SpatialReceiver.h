@@ -8,6 +8,7 @@
 #include "EngineClasses/SpatialNetDriver.h"
 #include "EngineClasses/SpatialPackageMapClient.h"
 #include "Interop/SpatialClassInfoManager.h"
+#include "Schema/DynamicComponent.h"
 #include "Schema/SpawnData.h"
 #include "Schema/StandardLibrary.h"
 #include "Schema/UnrealObjectRef.h"
@@ -26,12 +27,25 @@ class UGlobalStateManager;
 struct PendingAddComponentWrapper
 {
 	PendingAddComponentWrapper() = default;
-	PendingAddComponentWrapper(Worker_EntityId InEntityId, Worker_ComponentId InComponentId, const TSharedPtr<improbable::Component>& InData)
+	PendingAddComponentWrapper(Worker_EntityId InEntityId, Worker_ComponentId InComponentId, Worker_ComponentData* InData)
 		: EntityId(InEntityId), ComponentId(InComponentId), Data(InData) {}
 
 	Worker_EntityId EntityId;
 	Worker_ComponentId ComponentId;
-	TSharedPtr<improbable::Component> Data;
+
+	// Acquired from the add component op, so it stays valid if the critical section continues in a later op list.
+	// Acquiring only takes a reference, the data isn't copied. Released when the critical section is left.
+	Worker_ComponentData* Data;
+
+	// Index of the next pending component of the same entity, or INDEX_NONE if this is the last one.
+	int32 NextIndex = INDEX_NONE;
+};
+
+// First and last index in USpatialReceiver::PendingAddComponents of the components added to one entity.
+struct FPendingAddComponentList
+{
+	int32 First;
+	int32 Last;
 };
 
 struct FObjectReferences
@@ -83,12 +97,26 @@ struct FPendingIncomingRPC
 	TArray<uint8> PayloadData;
 	int64 CountBits;
 #if !UE_BUILD_SHIPPING
-	FString SenderWorkerId;
+	FName SenderWorkerId;
 #endif // !UE_BUILD_SHIPPING
 };
 
 using FIncomingRPCArray = TArray<TSharedPtr<FPendingIncomingRPC>>;
 
+// An entity which has been checked out but whose actor hasn't been spawned yet, see USpatialNetDriver::EntityCheckoutBudgetMs.
+struct FQueuedEntityCheckout
+{
+	Worker_EntityId EntityId;
+
+	// Data of the Unreal components added in the entity's critical section, acquired as it has to outlive the op list.
+	TArray<TSharedPtr<improbable::DynamicComponent>> Components;
+
+	// Ops received for the entity while it was queued, replayed once its actor has been spawned.
+	// The updates are acquired, so they outlive the op list they came in.
+	TArray<Worker_AuthorityChangeOp> AuthorityChanges;
+	TArray<Worker_ComponentUpdate*> ComponentUpdates;
+};
+
 DECLARE_DELEGATE_OneParam(EntityQueryDelegate, Worker_EntityQueryResponseOp&);
 DECLARE_DELEGATE_OneParam(ReserveEntityIDsDelegate, Worker_ReserveEntityIdsResponseOp&);
 
@@ -102,12 +130,16 @@ public:
 
 	// Dispatcher Calls
 	void OnCriticalSection(bool InCriticalSection);
+	// Sizes the critical section staging for the ops the dispatcher found in the critical section that is about to be entered.
+	void ReserveCriticalSection(int32 NumAddEntities, int32 NumAddComponents, int32 NumAuthorityChanges);
 	void OnAddEntity(Worker_AddEntityOp& Op);
 	void OnAddComponent(Worker_AddComponentOp& Op);
 	void OnRemoveEntity(Worker_RemoveEntityOp& Op);
 	void OnAuthorityChange(Worker_AuthorityChangeOp& Op);
 
 	void OnComponentUpdate(Worker_ComponentUpdateOp& Op);
+	// Applies all the updates received for one component of an entity in a single op list, in the order they were received.
+	void OnComponentUpdates(Worker_EntityId EntityId, Worker_ComponentId ComponentId, const TArray<const Worker_ComponentUpdate*>& Updates);
 	void OnCommandRequest(Worker_CommandRequestOp& Op);
 	void OnCommandResponse(Worker_CommandResponseOp& Op);
 
@@ -128,12 +160,28 @@ public:
 	void ResolvePendingOperations(UObject* Object, const FUnrealObjectRef& ObjectRef);
 	void FlushRetryRPCs();
 
+	// Calls the RepNotifies collected by actor channels while applying updates, once per object and property.
+	void AddChannelWithPendingRepNotifies(USpatialActorChannel* Channel);
+	void FlushRepNotifies();
+
+	// Spawns queued entities until this frame's checkout budget is spent.
+	void ProcessQueuedEntityCheckouts();
+
+	// Used by USpatialMetrics.
+	int32 GetNumUnresolvedRefs() const;
+	int32 GetNumPendingReliableRPCs() const { return PendingReliableRPCs.Num(); }
+
 private:
 	void EnterCriticalSection();
 	void LeaveCriticalSection();
 
-	void ReceiveActor(Worker_EntityId EntityId);
+	void ReceiveActor(Worker_EntityId EntityId, const FQueuedEntityCheckout* QueuedCheckout = nullptr);
+	bool ShouldQueueEntityCheckout(Worker_EntityId EntityId) const;
+	void QueueEntityCheckout(Worker_EntityId EntityId);
+	void CheckoutQueuedEntity(Worker_EntityId EntityId);
+	void DropQueuedEntityCheckout(Worker_EntityId EntityId);
 	void RemoveActor(Worker_EntityId EntityId);
+	bool TryPoolActor(AActor* Actor, Worker_EntityId EntityId);
 	AActor* CreateActor(improbable::SpawnData* SpawnData, UClass* ActorClass, bool bDeferred);
 
 	static FTransform GetRelativeSpawnTransform(UClass* ActorClass, FTransform SpawnTransform);
@@ -141,30 +189,30 @@ private:
 	void HandleActorAuthority(Worker_AuthorityChangeOp& Op);
 
 	void ApplyComponentData(Worker_EntityId EntityId, Worker_ComponentData& Data, USpatialActorChannel* Channel);
-	void ApplyComponentUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject* TargetObject, USpatialActorChannel* Channel, bool bIsHandover);
+	void ApplyComponentUpdates(const TArray<const Worker_ComponentUpdate*>& ComponentUpdates, UObject* TargetObject, USpatialActorChannel* Channel, bool bIsHandover);
 
-	void ReceiveRPCCommandRequest(const Worker_CommandRequest& CommandRequest, UObject* TargetObject, UFunction* Function, const FString& SenderWorkerId);
-	void ReceiveMulticastUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject* TargetObject, const TArray<UFunction*>& RPCArray);
-	void ApplyRPC(UObject* TargetObject, UFunction* Function, TArray<uint8>& PayloadData, int64 CountBits, const FString& SenderWorkerId);
+	void ReceiveRPCCommandRequest(const Worker_CommandRequest& CommandRequest, UObject* TargetObject, UFunction* Function, FName SenderWorkerId);
+	void ReceiveMulticastUpdates(const TArray<const Worker_ComponentUpdate*>& ComponentUpdates, UObject* TargetObject, const TArray<UFunction*>& RPCArray);
+	void ReceiveUnreliableRPCUpdate(const Worker_ComponentUpdate& ComponentUpdate, USpatialActorChannel* Channel, UObject* TargetObject, const TArray<UFunction*>& RPCArray);
+	// Applies the RPCs in the ring buffer of the endpoint which this worker hasn't received yet, and acknowledges them.
+	void ReceiveRingBufferRPCs(Worker_EntityId EntityId, Worker_ComponentId ComponentId);
+	void ApplyRPC(UObject* TargetObject, UFunction* Function, TArray<uint8>& PayloadData, int64 CountBits, FName SenderWorkerId);
 
 	void ReceiveCommandResponse(Worker_CommandResponseOp& Op);
 
 	void QueueIncomingRepUpdates(FChannelObjectPair ChannelObjectPair, const FObjectReferencesMap& ObjectReferencesMap, const TSet<FUnrealObjectRef>& UnresolvedRefs);
-	void QueueIncomingRPC(const TSet<FUnrealObjectRef>& UnresolvedRefs, UObject* TargetObject, UFunction* Function, const TArray<uint8>& PayloadData, int64 CountBits, const FString& SenderWorkerId);
+	void QueueIncomingRPC(const TSet<FUnrealObjectRef>& UnresolvedRefs, UObject* TargetObject, UFunction* Function, const TArray<uint8>& PayloadData, int64 CountBits, FName SenderWorkerId);
 
 	void ResolvePendingOperations_Internal(UObject* Object, const FUnrealObjectRef& ObjectRef);
 	void ResolveIncomingOperations(UObject* Object, const FUnrealObjectRef& ObjectRef);
 	void ResolveIncomingRPCs(UObject* Object, const FUnrealObjectRef& ObjectRef);
-	void ResolveObjectReferences(FRepLayout& RepLayout, UObject* ReplicatedObject, FObjectReferencesMap& ObjectReferencesMap, uint8* RESTRICT StoredData, uint8* RESTRICT Data, int32 MaxAbsOffset, TArray<UProperty*>& RepNotifies, bool& bOutSomeObjectsWereMapped, bool& bOutStillHasUnresolved);
+	void ResolveObjectReferences(FRepLayout& RepLayout, UObject* ReplicatedObject, FObjectReferencesMap& ObjectReferencesMap, uint8* RESTRICT StoredData, uint8* RESTRICT Data, int32 MaxAbsOffset, TBitArray<>& RepNotifies, bool& bOutSomeObjectsWereMapped, bool& bOutStillHasUnresolved);
 
 	void ProcessQueuedResolvedObjects();
 	void UpdateShadowData(Worker_EntityId EntityId);
 	TWeakObjectPtr<USpatialActorChannel> PopPendingActorRequest(Worker_RequestId RequestId);
 
 private:
-	template <typename T>
-	friend T* GetComponentData(USpatialReceiver& Receiver, Worker_EntityId EntityId);
-
 	UPROPERTY()
 	USpatialNetDriver* NetDriver;
 
@@ -195,12 +243,23 @@ private:
 	bool bInCriticalSection;
 	TArray<Worker_EntityId> PendingAddEntities;
 	TArray<Worker_AuthorityChangeOp> PendingAuthorityChanges;
+	// Components added during the current critical section. They are chained per entity, so an entity's components can be
+	// found without scanning the whole array. The staging containers are reset when leaving the critical section but keep their memory.
 	TArray<PendingAddComponentWrapper> PendingAddComponents;
+	TMap<Worker_EntityId_Key, FPendingAddComponentList> EntityPendingAddComponents;
 	TArray<Worker_EntityId> PendingRemoveEntities;
 
+	TMap<Worker_EntityId_Key, FQueuedEntityCheckout> QueuedEntityCheckouts;
+
+	TArray<TWeakObjectPtr<USpatialActorChannel>> ChannelsWithPendingRepNotifies;
+
 	TMap<Worker_RequestId, TWeakObjectPtr<USpatialActorChannel>> PendingActorRequests;
 	FReliableRPCMap PendingReliableRPCs;
 
+	// Id of the last RPC received from the ring buffer of each entity this worker acknowledges RPCs on. Our own acknowledgements
+	// reach the view late, so it's only read when we start receiving the RPCs of an entity.
+	TMap<Worker_EntityId_Key, uint64> LastReceivedRingBufferRPCIds;
+
 	TMap<Worker_RequestId, EntityQueryDelegate> EntityQueryDelegates;
 	TMap<Worker_RequestId, ReserveEntityIDsDelegate> ReserveEntityIDsDelegates;
 };
@@ -49,6 +49,23 @@ using FChannelToHandleToUnresolved = TMap<FChannelObjectPair, FHandleToUnresolve
 using FOutgoingRepUpdates = TMap<TWeakObjectPtr<const UObject>, FChannelToHandleToUnresolved>;
 using FUpdatesQueuedUntilAuthority = TMap<Worker_EntityId_Key, TArray<Worker_ComponentUpdate>>;
 
+// Consecutive multicast RPCs sent on one component of an entity in this tick, batched as events of a single update.
+struct FPendingMulticastUpdate
+{
+	Worker_EntityId EntityId;
+	Worker_ComponentUpdate Update = {};
+	// Event index of the last RPC added, see USpatialSender::AddBatchedMulticastEvent.
+	Schema_FieldId LastEventIndex = 0;
+};
+
+// The RPC ring buffer this worker writes on an entity, see USpatialNetDriver::bUseRPCRingBuffers.
+struct FOutgoingRPCRingBuffer
+{
+	uint64 LastSentRPCId;
+	// RPCs waiting for the other endpoint to acknowledge enough RPCs to make space in the buffer, in the order they were sent.
+	TArray<TSharedRef<FPendingRPCParams>> OverflowedRPCs;
+};
+
 UCLASS()
 class SPATIALGDK_API USpatialSender : public UObject
 {
@@ -57,6 +74,8 @@ class SPATIALGDK_API USpatialSender : public UObject
 public:
 	void Init(USpatialNetDriver* InNetDriver);
 
+	virtual void BeginDestroy() override;
+
 	// Actor Updates
 	void SendComponentUpdates(UObject* Object, const FClassInfo& Info, USpatialActorChannel* Channel, const FRepChangeState* RepChanges, const FHandoverChangeState* HandoverChanges);
 	void SendComponentInterest(AActor* Actor, Worker_EntityId EntityId);
@@ -65,6 +84,18 @@ public:
 	void FlushRetryRPCs();
 	void SendRPC(TSharedRef<FPendingRPCParams> Params);
 	void SendCommandResponse(Worker_RequestId request_id, Worker_CommandResponse& Response);
+	// Sends the multicast RPCs batched since the last flush, called by the net driver before and after replicating actors.
+	void FlushMulticastRPCs();
+	// Sends the batched multicast RPCs of one entity, before its entity is deleted or authority over it moves.
+	void FlushMulticastRPCs(Worker_EntityId EntityId);
+
+	// RPC ring buffers
+	void SendRPCEndpointAck(Worker_EntityId EntityId, Worker_ComponentId ComponentId, uint64 LastAckedRPCId);
+	// Sends the RPCs which overflowed the ring buffer of the entity, once the other endpoint acknowledged some.
+	void FlushOverflowedRingBufferRPCs(Worker_EntityId EntityId);
+	// Sends the overflowed RPCs as commands, since this worker can no longer write the ring buffer of the entity.
+	void OnRPCEndpointAuthorityLost(Worker_EntityId EntityId);
+	void RemoveRPCRingBuffer(Worker_EntityId EntityId);
 
 	void SendReserveEntityIdRequest(USpatialActorChannel* Channel);
 	void SendCreateEntityRequest(USpatialActorChannel* Channel);
@@ -76,6 +107,11 @@ public:
 	bool UpdateEntityACLs(AActor* Actor, Worker_EntityId EntityId);
 
 	void ProcessUpdatesQueuedUntilAuthority(Worker_EntityId EntityId);
+
+	// Used by USpatialMetrics.
+	uint32 GetNumRetriedRPCs() const { return NumRetriedRPCs; }
+	int32 GetNumQueuedOutgoingOperations() const;
+
 private:
 	// Actor Lifecycle
 	Worker_RequestId CreateEntity(USpatialActorChannel* Channel);
@@ -85,11 +121,22 @@ private:
 	void QueueOutgoingUpdate(USpatialActorChannel* DependentChannel, UObject* ReplicatedObject, int16 Handle, const TSet<TWeakObjectPtr<const UObject>>& UnresolvedObjects, bool bIsHandover);
 	void QueueOutgoingRPC(const UObject* UnresolvedObject, TSharedRef<FPendingRPCParams> Params);
 
+	// Sends an unreliable client or server RPC as an event, if this worker is authoritative over the RPC component it goes on.
+	// Returns false if the RPC should be sent as a command instead.
+	bool SendUnreliableRPCEvent(UObject* TargetObject, UFunction* Function, void* Parameters, const FClassInfo& Info, const FRPCInfo& RPCInfo, const UObject*& OutUnresolvedObject);
+
+	// Writes a reliable client or server RPC to the ring buffer of the endpoint this worker is authoritative over, or queues it
+	// if the buffer is full. Returns false if the RPC should be sent as a command instead.
+	bool SendRingBufferRPC(TSharedRef<FPendingRPCParams> Params, const FRPCInfo& RPCInfo, const UObject*& OutUnresolvedObject);
+
 	// RPC Construction
 	Worker_CommandRequest CreateRPCCommandRequest(UObject* TargetObject, UFunction* Function, void* Parameters, Worker_ComponentId ComponentId, Schema_FieldId CommandIndex, Worker_EntityId& OutEntityId, const UObject*& OutUnresolvedObject, int ReliableRPCIndex);
-	Worker_ComponentUpdate CreateMulticastUpdate(UObject* TargetObject, UFunction* Function, void* Parameters, Worker_ComponentId ComponentId, Schema_FieldId EventIndex, Worker_EntityId& OutEntityId, const UObject*& OutUnresolvedObject);
+	void SendMulticastRPC(UObject* TargetObject, UFunction* Function, void* Parameters, Worker_ComponentId ComponentId, Schema_FieldId EventIndex, const UObject*& OutUnresolvedObject);
+	Schema_Object* AddBatchedMulticastEvent(Worker_EntityId EntityId, Worker_ComponentId ComponentId, Schema_FieldId EventIndex);
+	void SendPendingMulticastUpdate(FPendingMulticastUpdate& PendingUpdate);
+	Worker_ComponentUpdate CreateUnreliableRPCUpdate(UObject* TargetObject, UFunction* Function, void* Parameters, Worker_ComponentId ComponentId, uint32 RPCIndex, Worker_EntityId& OutEntityId, const UObject*& OutUnresolvedObject);
 
-	TArray<Worker_InterestOverride> CreateComponentInterest(AActor* Actor, bool bIsNetOwned);
+	TArray<Worker_InterestOverride> CreateComponentInterest(AActor* Actor, bool bIsNetOwned, bool bMulticastsCulled);
 	FString GetOwnerWorkerAttribute(AActor* Actor);
 
 private:
@@ -122,6 +169,15 @@ private:
 	TMap<Worker_RequestId, USpatialActorChannel*> PendingActorRequests;
 
 	TArray<TSharedRef<FPendingRPCParams>> RetryRPCs;
+	// Total number of RPCs queued for a retry.
+	uint32 NumRetriedRPCs;
 
 	FUpdatesQueuedUntilAuthority UpdatesQueuedUntilAuthorityMap;
+
+	TMap<Worker_EntityId_Key, FOutgoingRPCRingBuffer> OutgoingRPCRingBuffers;
+
+	// In the order the RPCs were called, so RPCs alternating between the components of an actor and its subobjects stay in order.
+	TArray<FPendingMulticastUpdate> PendingMulticastUpdates;
+	// Index in PendingMulticastUpdates of the last update of each entity, which new events are added to if they can be.
+	TMap<Worker_EntityId_Key, int32> LastPendingMulticastUpdateIndices;
 };
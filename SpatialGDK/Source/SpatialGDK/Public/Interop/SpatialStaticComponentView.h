@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 
 #include "Schema/Component.h"
+#include "Schema/RPCEndpoint.h"
 #include "Schema/StandardLibrary.h"
 #include "Schema/UnrealMetadata.h"
 #include "SpatialConstants.h"
@@ -37,12 +38,25 @@ public:
 		return nullptr;
 	}
 
+	// The ClientRPCEndpoint or ServerRPCEndpoint of the entity, as the RPC ring buffer code handles both the same way.
+	improbable::RPCEndpoint* GetRPCEndpoint(Worker_EntityId EntityId, Worker_ComponentId ComponentId);
+
 	void OnAddComponent(const Worker_AddComponentOp& Op);
 	void OnRemoveEntity(const Worker_RemoveEntityOp& Op);
 	void OnComponentUpdate(const Worker_ComponentUpdateOp& Op);
 	void OnAuthorityChange(const Worker_AuthorityChangeOp& Op);
 
 private:
+	template <typename T>
+	TUniquePtr<improbable::ComponentStorageBase> CreateComponentStorage(const Worker_ComponentData& Data);
+
+	template <typename T>
+	void ApplyComponentData(Worker_EntityId EntityId, const Worker_ComponentData& Data);
+
 	TMap<Worker_EntityId_Key, TMap<Worker_ComponentId, Worker_Authority>> EntityComponentAuthorityMap;
 	TMap<Worker_EntityId_Key, TMap<Worker_ComponentId, TUniquePtr<improbable::ComponentStorageBase>>> EntityComponentMap;
+
+	// Storage of removed EntityAcl, Metadata and Position components, reused by the next entities added so that
+	// entities coming in and out of view don't allocate new storage for their standard library components.
+	TMap<Worker_ComponentId, TArray<TUniquePtr<improbable::ComponentStorageBase>>> ComponentStoragePool;
 };
@@ -0,0 +1,138 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "Misc/Optional.h"
+
+#include "Schema/Component.h"
+#include "SpatialConstants.h"
+#include "Utils/SchemaUtils.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+#include <WorkerSDK/improbable/c_worker.h>
+
+namespace improbable
+{
+
+struct RingBufferRPC
+{
+	uint32 Offset;
+	uint32 RPCIndex;
+	TArray<uint8> PayloadData;
+};
+
+// The ring buffer of reliable RPCs one worker sends on an entity, and its acknowledgement of the RPCs it received from the
+// other endpoint, see USpatialNetDriver::bUseRPCRingBuffers. The owning client writes the ClientRPCEndpoint with its server
+// RPCs, and the authoritative server writes the ServerRPCEndpoint with its client RPCs.
+struct RPCEndpoint : Component
+{
+	RPCEndpoint() = default;
+
+	RPCEndpoint(const Worker_ComponentData& Data)
+	{
+		ReadFields(Schema_GetComponentDataFields(Data.schema_type));
+	}
+
+	void ApplyComponentUpdate(const Worker_ComponentUpdate& Update) override
+	{
+		ReadFields(Schema_GetComponentUpdateFields(Update.schema_type));
+	}
+
+	static Worker_ComponentData CreateRPCEndpointData(Worker_ComponentId ComponentId)
+	{
+		Worker_ComponentData Data = {};
+		Data.component_id = ComponentId;
+		Data.schema_type = Schema_CreateComponentData(ComponentId);
+		Schema_Object* ComponentObject = Schema_GetComponentDataFields(Data.schema_type);
+
+		Schema_AddUint64(ComponentObject, SpatialConstants::RPC_ENDPOINT_LAST_SENT_RPC_ID_ID, 0);
+		Schema_AddUint64(ComponentObject, SpatialConstants::RPC_ENDPOINT_LAST_ACKED_RPC_ID_ID, 0);
+
+		return Data;
+	}
+
+	static Worker_ComponentUpdate CreateAckUpdate(Worker_ComponentId ComponentId, uint64 LastAckedRPCId)
+	{
+		Worker_ComponentUpdate Update = {};
+		Update.component_id = ComponentId;
+		Update.schema_type = Schema_CreateComponentUpdate(ComponentId);
+		Schema_Object* ComponentObject = Schema_GetComponentUpdateFields(Update.schema_type);
+
+		Schema_AddUint64(ComponentObject, SpatialConstants::RPC_ENDPOINT_LAST_ACKED_RPC_ID_ID, LastAckedRPCId);
+
+		return Update;
+	}
+
+	static Schema_FieldId GetRingBufferFieldId(uint64 RPCId)
+	{
+		return SpatialConstants::RPC_ENDPOINT_RING_BUFFER_FIRST_ID + (Schema_FieldId)((RPCId - 1) % SpatialConstants::RPC_RING_BUFFER_SIZE);
+	}
+
+	const TOptional<RingBufferRPC>& GetRPC(uint64 RPCId) const
+	{
+		return RingBuffer[(RPCId - 1) % SpatialConstants::RPC_RING_BUFFER_SIZE];
+	}
+
+	uint64 LastSentRPCId = 0;
+	uint64 LastAckedRPCId = 0;
+	TOptional<RingBufferRPC> RingBuffer[SpatialConstants::RPC_RING_BUFFER_SIZE];
+
+private:
+	// Component data has every field, an update only the ones which changed.
+	void ReadFields(Schema_Object* ComponentObject)
+	{
+		if (Schema_GetUint64Count(ComponentObject, SpatialConstants::RPC_ENDPOINT_LAST_SENT_RPC_ID_ID) > 0)
+		{
+			LastSentRPCId = Schema_GetUint64(ComponentObject, SpatialConstants::RPC_ENDPOINT_LAST_SENT_RPC_ID_ID);
+		}
+
+		if (Schema_GetUint64Count(ComponentObject, SpatialConstants::RPC_ENDPOINT_LAST_ACKED_RPC_ID_ID) > 0)
+		{
+			LastAckedRPCId = Schema_GetUint64(ComponentObject, SpatialConstants::RPC_ENDPOINT_LAST_ACKED_RPC_ID_ID);
+		}
+
+		for (uint32 Slot = 0; Slot < SpatialConstants::RPC_RING_BUFFER_SIZE; Slot++)
+		{
+			const Schema_FieldId FieldId = SpatialConstants::RPC_ENDPOINT_RING_BUFFER_FIRST_ID + Slot;
+			if (Schema_GetObjectCount(ComponentObject, FieldId) > 0)
+			{
+				Schema_Object* RPCObject = Schema_GetObject(ComponentObject, FieldId);
+
+				RingBufferRPC RPC;
+				RPC.Offset = Schema_GetUint32(RPCObject, SpatialConstants::RING_BUFFER_RPC_OFFSET_ID);
+				RPC.RPCIndex = Schema_GetUint32(RPCObject, SpatialConstants::RING_BUFFER_RPC_INDEX_ID);
+				RPC.PayloadData = GetBytesFromSchema(RPCObject, SpatialConstants::RING_BUFFER_RPC_PAYLOAD_ID);
+				RingBuffer[Slot] = MoveTemp(RPC);
+			}
+		}
+	}
+};
+
+struct ClientRPCEndpoint : RPCEndpoint
+{
+	static const Worker_ComponentId ComponentId = SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID;
+
+	ClientRPCEndpoint() = default;
+	ClientRPCEndpoint(const Worker_ComponentData& Data) : RPCEndpoint(Data) {}
+};
+
+struct ServerRPCEndpoint : RPCEndpoint
+{
+	static const Worker_ComponentId ComponentId = SpatialConstants::SERVER_RPC_ENDPOINT_COMPONENT_ID;
+
+	ServerRPCEndpoint() = default;
+	ServerRPCEndpoint(const Worker_ComponentData& Data) : RPCEndpoint(Data) {}
+};
+
+// The endpoint a worker sends RPCs of the given type on, and the endpoint the other side of the entity acknowledges them on.
+FORCEINLINE Worker_ComponentId GetRPCEndpointComponentId(ESchemaComponentType RPCType)
+{
+	return RPCType == SCHEMA_ServerRPC ? SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID : SpatialConstants::SERVER_RPC_ENDPOINT_COMPONENT_ID;
+}
+
+FORCEINLINE Worker_ComponentId GetOtherRPCEndpointComponentId(Worker_ComponentId ComponentId)
+{
+	return ComponentId == SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID ? SpatialConstants::SERVER_RPC_ENDPOINT_COMPONENT_ID : SpatialConstants::CLIENT_RPC_ENDPOINT_COMPONENT_ID;
+}
+
+}
@@ -78,19 +78,16 @@ struct EntityAcl : Component
 
 	EntityAcl(const Worker_ComponentData& Data)
 	{
-		Schema_Object* ComponentObject = Schema_GetComponentDataFields(Data.schema_type);
-
-		ReadAcl = GetWorkerRequirementSetFromSchema(ComponentObject, 1);
+		ApplyComponentData(Data);
+	}
 
-		uint32 KVPairCount = Schema_GetObjectCount(ComponentObject, 2);
-		for (uint32 i = 0; i < KVPairCount; i++)
-		{
-			Schema_Object* KVPairObject = Schema_IndexObject(ComponentObject, 2, i);
-			uint32 Key = Schema_GetUint32(KVPairObject, SCHEMA_MAP_KEY_FIELD_ID);
-			WorkerRequirementSet Value = GetWorkerRequirementSetFromSchema(KVPairObject, SCHEMA_MAP_VALUE_FIELD_ID);
+	// Overwrites this ACL with the component data, reusing the memory of existing entries.
+	void ApplyComponentData(const Worker_ComponentData& Data)
+	{
+		Schema_Object* ComponentObject = Schema_GetComponentDataFields(Data.schema_type);
 
-			ComponentWriteAcl.Add(Key, Value);
-		}
+		GetWorkerRequirementSetFromSchema(ComponentObject, 1, ReadAcl);
+		ApplyComponentWriteAcl(ComponentObject);
 	}
 
 	void ApplyComponentUpdate(const Worker_ComponentUpdate& Update)
@@ -99,22 +96,13 @@ struct EntityAcl : Component
 
 		if (Schema_GetObjectCount(ComponentObject, 1) > 0)
 		{
-			ReadAcl = GetWorkerRequirementSetFromSchema(ComponentObject, 1);
+			GetWorkerRequirementSetFromSchema(ComponentObject, 1, ReadAcl);
 		}
 
 		// This is never emptied, so does not need an additional check for cleared fields
-		uint32 KVPairCount = Schema_GetObjectCount(ComponentObject, 2);
-		if (KVPairCount > 0)
+		if (Schema_GetObjectCount(ComponentObject, 2) > 0)
 		{
-			ComponentWriteAcl.Empty();
-			for (uint32 i = 0; i < KVPairCount; i++)
-			{
-				Schema_Object* KVPairObject = Schema_IndexObject(ComponentObject, 2, i);
-				uint32 Key = Schema_GetUint32(KVPairObject, SCHEMA_MAP_KEY_FIELD_ID);
-				WorkerRequirementSet Value = GetWorkerRequirementSetFromSchema(KVPairObject, SCHEMA_MAP_VALUE_FIELD_ID);
-
-				ComponentWriteAcl.Add(Key, Value);
-			}
+			ApplyComponentWriteAcl(ComponentObject);
 		}
 	}
 
@@ -158,6 +146,33 @@ struct EntityAcl : Component
 
 	WorkerRequirementSet ReadAcl;
 	WriteAclMap ComponentWriteAcl;
+
+private:
+	// Updates existing write ACL entries in place, as most updates only change a few of them.
+	void ApplyComponentWriteAcl(Schema_Object* ComponentObject)
+	{
+		uint32 KVPairCount = Schema_GetObjectCount(ComponentObject, 2);
+
+		TSet<Worker_ComponentId, DefaultKeyFuncs<Worker_ComponentId>, TInlineSetAllocator<64>> UpdatedComponents;
+		for (uint32 i = 0; i < KVPairCount; i++)
+		{
+			Schema_Object* KVPairObject = Schema_IndexObject(ComponentObject, 2, i);
+			uint32 Key = Schema_GetUint32(KVPairObject, SCHEMA_MAP_KEY_FIELD_ID);
+			GetWorkerRequirementSetFromSchema(KVPairObject, SCHEMA_MAP_VALUE_FIELD_ID, ComponentWriteAcl.FindOrAdd(Key));
+			UpdatedComponents.Add(Key);
+		}
+
+		if (UpdatedComponents.Num() != ComponentWriteAcl.Num())
+		{
+			for (auto It = ComponentWriteAcl.CreateIterator(); It; ++It)
+			{
+				if (!UpdatedComponents.Contains(It.Key()))
+				{
+					It.RemoveCurrent();
+				}
+			}
+		}
+	}
 };
 
 struct Metadata : Component
@@ -170,10 +185,15 @@ struct Metadata : Component
 		: EntityType(InEntityType) {}
 
 	Metadata(const Worker_ComponentData& Data)
+	{
+		ApplyComponentData(Data);
+	}
+
+	void ApplyComponentData(const Worker_ComponentData& Data)
 	{
 		Schema_Object* ComponentObject = Schema_GetComponentDataFields(Data.schema_type);
 
-		EntityType = GetStringFromSchema(ComponentObject, 1);
+		IndexStringFromSchema(ComponentObject, 1, 0, EntityType);
 	}
 
 	Worker_ComponentData CreateMetadataData()
@@ -201,6 +221,11 @@ struct Position : Component
 		: Coords(InCoords) {}
 
 	Position(const Worker_ComponentData& Data)
+	{
+		ApplyComponentData(Data);
+	}
+
+	void ApplyComponentData(const Worker_ComponentData& Data)
 	{
 		Schema_Object* ComponentObject = Schema_GetComponentDataFields(Data.schema_type);
 
@@ -234,10 +259,11 @@ struct Position : Component
 	void ApplyComponentUpdate(const Worker_ComponentUpdate& Update)
 	{
 		Schema_Object* ComponentObject = Schema_GetComponentUpdateFields(Update.schema_type);
-		Schema_Object* CoordsObject = Schema_GetObject(ComponentObject, 1);
-		Coords.X = Schema_GetDouble(CoordsObject, 1);
-		Coords.Y = Schema_GetDouble(CoordsObject, 2);
-		Coords.Z = Schema_GetDouble(CoordsObject, 3);
+
+		if (Schema_GetObjectCount(ComponentObject, 1) > 0)
+		{
+			Coords = GetCoordinateFromSchema(ComponentObject, 1);
+		}
 	}
 
 	Coordinates Coords;
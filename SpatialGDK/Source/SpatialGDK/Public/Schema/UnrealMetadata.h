@@ -50,17 +50,9 @@ struct UnrealMetadata : Component
 		return Data;
 	}
 
-	FORCEINLINE UClass* GetNativeEntityClass()
+	FORCEINLINE UClass* GetNativeEntityClass(USpatialClassInfoManager* ClassInfoManager) const
 	{
-		if (UClass* Class = FindObject<UClass>(ANY_PACKAGE, *ClassPath))
-		{
-			if (Class->IsChildOf<AActor>())
-			{
-				return Class;
-			}
-		}
-
-		return nullptr;
+		return ClassInfoManager->GetActorClassByPath(ClassPath);
 	}
 
 	FString StaticPath;
@@ -69,7 +69,8 @@ struct FUnrealObjectRef
 	Worker_EntityId Entity;
 	uint32 Offset;
 	improbable::TSchemaOption<FString> Path;
-	improbable::TSchemaOption<FUnrealObjectRef> Outer;
+	// Shared between copies, as an inline optional can't contain its own type.
+	improbable::TSharedSchemaOption<FUnrealObjectRef> Outer;
 };
 
 inline uint32 GetTypeHash(const FUnrealObjectRef& ObjectRef)
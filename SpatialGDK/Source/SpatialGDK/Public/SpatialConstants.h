@@ -104,6 +104,8 @@ namespace SpatialConstants
 	const Worker_ComponentId UNREAL_METADATA_COMPONENT_ID					= 100004;
 	const Worker_ComponentId SINGLETON_MANAGER_COMPONENT_ID					= 100005;
 	const Worker_ComponentId DEPLOYMENT_MAP_COMPONENT_ID					= 100006;
+	const Worker_ComponentId CLIENT_RPC_ENDPOINT_COMPONENT_ID				= 100007;
+	const Worker_ComponentId SERVER_RPC_ENDPOINT_COMPONENT_ID				= 100008;
 	const Worker_ComponentId STARTING_GENERATED_COMPONENT_ID				= 100010;
 
 	const Schema_FieldId GLOBAL_STATE_MANAGER_MAP_URL_ID			= 1;
@@ -111,6 +113,30 @@ namespace SpatialConstants
 
 	const Schema_FieldId ACTOR_COMPONENT_REPLICATES_ID = 1;
 
+	// The latency_trace event of generated data and handover components, and the fields of its UnrealLatencyTrace type.
+	const Schema_FieldId LATENCY_TRACE_EVENT_ID			= 1;
+	const Schema_FieldId LATENCY_TRACE_ID_ID			= 1;
+	const Schema_FieldId LATENCY_TRACE_SEND_TIME_ID		= 2;
+	const Schema_FieldId LATENCY_TRACE_SEND_DURATION_ID	= 3;
+
+	// The unreliable_rpc event of generated ClientRPC and ServerRPC components, and the fields of its UnrealUnreliableRPC type.
+	const Schema_FieldId UNRELIABLE_RPC_EVENT_ID		= 1;
+	const Schema_FieldId UNRELIABLE_RPC_PAYLOAD_ID		= 1;
+	const Schema_FieldId UNRELIABLE_RPC_INDEX_ID		= 2;
+	const Schema_FieldId UNRELIABLE_RPC_SEQUENCE_ID		= 3;
+	// Events with a sequence this far behind the last one received are stale, anything further behind is from a new sender.
+	const uint32 UNRELIABLE_RPC_SEQUENCE_WINDOW			= 64;
+
+	// The fields of the ClientRPCEndpoint and ServerRPCEndpoint components, and of their UnrealRingBufferRPC type.
+	const Schema_FieldId RPC_ENDPOINT_LAST_SENT_RPC_ID_ID		= 1;
+	const Schema_FieldId RPC_ENDPOINT_LAST_ACKED_RPC_ID_ID		= 2;
+	// RPC n of an endpoint is in field RPC_ENDPOINT_RING_BUFFER_FIRST_ID + (n - 1) % RPC_RING_BUFFER_SIZE.
+	const Schema_FieldId RPC_ENDPOINT_RING_BUFFER_FIRST_ID		= 3;
+	const uint32 RPC_RING_BUFFER_SIZE							= 32;
+	const Schema_FieldId RING_BUFFER_RPC_OFFSET_ID				= 1;
+	const Schema_FieldId RING_BUFFER_RPC_INDEX_ID				= 2;
+	const Schema_FieldId RING_BUFFER_RPC_PAYLOAD_ID				= 3;
+
 	const float FIRST_COMMAND_RETRY_WAIT_SECONDS = 0.2f;
 	const float REPLICATED_STABLY_NAMED_ACTORS_DELETION_TIMEOUT_SECONDS = 5.0f;
 	const uint32 MAX_NUMBER_COMMAND_ATTEMPTS = 5u;
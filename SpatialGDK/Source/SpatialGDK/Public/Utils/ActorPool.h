@@ -0,0 +1,56 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "ActorPool.generated.h"
+
+class USpatialNetDriver;
+
+// Keeps actors of the classes listed in USpatialNetDriver::PooledActorClasses alive after their entity leaves interest, so that
+// they can be re-bound to the next entity of the same class instead of being destroyed and spawned again.
+UCLASS()
+class SPATIALGDK_API UActorPool : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	void Init(USpatialNetDriver* InNetDriver);
+
+	bool IsPooledClass(UClass* Class);
+
+	// Whether the pool of the class can take another actor, checked before an actor is unbound from its entity for pooling.
+	bool HasCapacity(UClass* Class) const;
+
+	/**
+	* Takes an actor of exactly the given class out of the pool, moves it to Transform and reactivates it.
+	* Returns nullptr if the pool has no actor of that class.
+	*
+	* @param Class the class of the actor to reuse.
+	* @param Transform the absolute transform of the reused actor.
+	**/
+	AActor* AcquireActor(UClass* Class, const FTransform& Transform);
+
+	/**
+	* Deactivates an actor and puts it into the pool.
+	* Returns false if the actor's class isn't pooled or its pool is full, in which case the caller should destroy the actor.
+	*
+	* @param Actor the actor to pool. It must not be bound to an entity or actor channel anymore.
+	**/
+	bool ReleaseActor(AActor* Actor);
+
+	// Destroys all pooled actors.
+	void Empty();
+
+private:
+	UPROPERTY()
+	USpatialNetDriver* NetDriver;
+
+	UPROPERTY()
+	TArray<UClass*> PooledClasses;
+
+	// Weak keys, as classes can be unloaded while the pool is alive, e.g. by hot reload.
+	TMap<TWeakObjectPtr<UClass>, bool> IsPooledClassCache;
+	TMap<TWeakObjectPtr<UClass>, TArray<TWeakObjectPtr<AActor>>> PooledActors;
+};
@@ -0,0 +1,68 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "SpatialConstants.h"
+
+#include <WorkerSDK/improbable/c_schema.h>
+
+// Records the schema size of outgoing property updates per object class, component type and field, and of outgoing RPCs per
+// function. Sizes are summed over fixed time windows, so a dump shows both the bandwidth of the last complete window and the total
+// since recording started. Controlled with the SPATIALBANDWIDTH console command of USpatialNetDriver.
+class SPATIALGDK_API FBandwidthProfiler
+{
+public:
+	FBandwidthProfiler();
+
+	FORCEINLINE bool IsRecording() const
+	{
+		return bRecording;
+	}
+
+	void StartRecording(float InWindowSeconds);
+	void StopRecording();
+	void Reset();
+
+	// Advances the current window, called once per net driver tick while recording.
+	void Tick(float DeltaTime);
+
+	void RecordField(UClass* Class, ESchemaComponentType Type, Schema_FieldId FieldId, UProperty* Property, uint32 NumBytes);
+	void RecordRPC(UFunction* Function, uint32 NumBytes);
+
+	// Logs the fields and RPCs which sent the most bytes in the last complete window (or so far, if no window has completed yet).
+	void Dump(FOutputDevice& Ar, int32 MaxEntries) const;
+
+private:
+	struct FByteCount
+	{
+		uint64 Bytes = 0;
+		uint32 Count = 0;
+	};
+
+	struct FBandwidthEntry
+	{
+		FString Name;
+		FByteCount CurrentWindow;
+		FByteCount LastWindow;
+		FByteCount Total;
+
+		void Add(uint32 NumBytes);
+	};
+
+	void DumpEntries(FOutputDevice& Ar, const TCHAR* Title, const TArray<const FBandwidthEntry*>& Entries, int32 MaxEntries) const;
+
+	// Keyed by class and function path, so that classes which are unloaded or reinstanced while recording don't leave dangling keys.
+	using FFieldKey = TTuple<FName, int32, Schema_FieldId>;
+
+	TMap<FFieldKey, FBandwidthEntry> FieldEntries;
+	TMap<FName, FBandwidthEntry> RPCEntries;
+
+	bool bRecording;
+	float WindowSeconds;
+	float CurrentWindowTime;
+	// Duration of the last completed window, 0 until the first window has completed.
+	float LastWindowTime;
+	float TotalTime;
+};
@@ -51,6 +51,8 @@ private:
 	void AddObjectToComponentInterest(UObject* Object, UObjectPropertyBase* Property, uint8* Data, improbable::ComponentInterest& ComponentInterest);
 
 	void AddProperty(Schema_Object* Object, Schema_FieldId FieldId, UProperty* Property, const uint8* Data, TSet<TWeakObjectPtr<const UObject>>& UnresolvedObjects, TArray<Schema_FieldId>* ClearedIds);
+	// Writes Count primitives at Data as one list field. Returns false if the elements aren't primitives.
+	bool AddPrimitiveList(Schema_Object* Object, Schema_FieldId FieldId, ESchemaFieldDecoder Decoder, const uint8* Data, uint32 Count);
 
 	USpatialNetDriver* NetDriver;
 	USpatialPackageMapClient* PackageMap;
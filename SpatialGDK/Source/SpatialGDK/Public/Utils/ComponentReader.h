@@ -3,6 +3,7 @@
 #pragma once
 
 #include "EngineClasses/SpatialNetBitReader.h"
+#include "Interop/SpatialClassInfoManager.h"
 #include "Interop/SpatialReceiver.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogSpatialComponentReader, All, All);
@@ -17,15 +18,20 @@ public:
 
 	void ApplyComponentData(const Worker_ComponentData& ComponentData, UObject* Object, USpatialActorChannel* Channel, bool bIsHandover);
 	void ApplyComponentUpdate(const Worker_ComponentUpdate& ComponentUpdate, UObject* Object, USpatialActorChannel* Channel, bool bIsHandover);
+	// Applies several updates to the same component, in order, as one update which holds the latest value of each field.
+	void ApplyComponentUpdates(const TArray<const Worker_ComponentUpdate*>& ComponentUpdates, UObject* Object, USpatialActorChannel* Channel, bool bIsHandover);
 
 private:
-	void ApplySchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArray<Schema_FieldId>& UpdatedIds);
-	void ApplyHandoverSchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArray<Schema_FieldId>& UpdatedIds);
+	// FieldObjects, if set, holds the schema object to read each of UpdatedIds from. Otherwise they're all read from ComponentObject.
+	void ApplySchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArray<Schema_FieldId>& UpdatedIds, const TArray<Schema_Object*>* FieldObjects = nullptr);
+	void ApplyHandoverSchemaObject(Schema_Object* ComponentObject, UObject* Object, USpatialActorChannel* Channel, bool bIsInitialData, TArray<Schema_FieldId>& UpdatedIds, const TArray<Schema_Object*>* FieldObjects = nullptr);
 
-	void ApplyProperty(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, uint32 Index, UProperty* Property, uint8* Data, int32 Offset, int32 ParentIndex);
+	void ApplyProperty(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, uint32 Index, UProperty* Property, ESchemaFieldDecoder Decoder, uint8* Data, int32 Offset, int32 ParentIndex);
+	// Reads a list of Count primitives into the elements at Data. Returns false if the elements aren't primitives.
+	bool ApplyPrimitiveList(Schema_Object* Object, Schema_FieldId FieldId, ESchemaFieldDecoder Decoder, uint8* Data, uint32 Count);
 	void ApplyArray(Schema_Object* Object, Schema_FieldId FieldId, FObjectReferencesMap& InObjectReferencesMap, UArrayProperty* Property, uint8* Data, int32 Offset, int32 ParentIndex);
 
-	uint32 GetPropertyCount(const Schema_Object* Object, Schema_FieldId Id, UProperty* Property);
+	uint32 GetPropertyCount(const Schema_Object* Object, Schema_FieldId Id, ESchemaFieldDecoder Decoder);
 
 private:
 	class USpatialPackageMapClient* PackageMap;
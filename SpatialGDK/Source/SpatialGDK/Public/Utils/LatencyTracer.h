@@ -0,0 +1,73 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Utils/TimeHistogram.h"
+
+#include <WorkerSDK/improbable/c_worker.h>
+
+DECLARE_LOG_CATEGORY_EXTERN(LogSpatialLatencyTracer, Log, All)
+
+// Measures the latency of replicated property updates from the sending worker to the receiving worker, split into stages.
+// The sender attaches a latency trace event to a sampled subset of the data and handover component updates it sends (see
+// USpatialNetDriver::LatencyTraceSampleRate), and every worker which applies a traced update adds its stage timings to a
+// histogram for the class of the updated object. The stages are:
+// - Send: time spent in the GDK building and sending the update, after its changes were found.
+// - Runtime: from sending the update until it arrived in an op list on the receiving worker, i.e. the time spent in SpatialOS.
+// - Receive queue: from the op list arriving until the GDK started applying the update.
+// - Apply: time spent in the GDK applying the update to the object.
+// Runtime time compares the wall clocks of two workers, so it is only as accurate as their clocks are in sync. When the
+// receiving worker's clock is behind, it is recorded as 0 and the skew is counted separately.
+// The results are shown with the SPATIALLATENCY console command of USpatialNetDriver.
+class SPATIALGDK_API FLatencyTracer
+{
+public:
+	FLatencyTracer();
+
+	static int64 GetTimestampMicroseconds();
+
+	// Adds a latency trace event to an outgoing update, which started being built at SendStartTime.
+	void AddTrace(Worker_ComponentUpdate& Update, int64 SendStartTime);
+
+	// Whether any of the updates has a latency trace, so the receiver only takes timestamps when there is something to record.
+	static bool HasTraces(const TArray<const Worker_ComponentUpdate*>& Updates);
+
+	void OnOpListReceived();
+
+	// Records the stage timings of the traced updates, which were applied to an object of Class starting at ApplyStartTime.
+	void RecordTraces(const TArray<const Worker_ComponentUpdate*>& Updates, UClass* Class, int64 ApplyStartTime);
+
+	void Dump(FOutputDevice& Ar) const;
+	void Reset();
+
+private:
+	enum EStage
+	{
+		Stage_Send,
+		Stage_Runtime,
+		Stage_ReceiveQueue,
+		Stage_Apply,
+		Stage_Total,
+		Stage_Count
+	};
+
+	struct FClassLatency
+	{
+		FClassLatency();
+
+		FString ClassName;
+		// Microsecond histograms.
+		FTimeHistogram Stages[Stage_Count];
+		// Traces which arrived before they were sent by the receiving worker's clock.
+		uint32 NumClockSkewedTraces;
+		int64 MaxClockSkewUs;
+	};
+
+	// Keyed by class path, so that classes which are unloaded or reinstanced don't leave dangling keys.
+	TMap<FName, FClassLatency> ClassLatencies;
+
+	uint32 NextTraceId;
+	int64 OpListReceivedTime;
+};
@@ -6,10 +6,47 @@
 #include "HAL/Platform.h"
 #include "Net/RepLayout.h"
 
-// Storage for a changelist created by the replication system when replicating from the server.
+// The replicated properties of an object to send, as a bitset over its top-level rep handles (indexed by handle - 1).
+// Dynamic arrays are always sent whole, so changes to their elements are tracked by the handle of the array.
+// Changelists from the replication system are merged in place, so merging several of them doesn't copy anything.
 struct FRepChangeState
 {
-	const TArray<uint16> RepChanged; // changed replicated properties
+	FRepChangeState(FRepLayout& InRepLayout)
+		: RepChanged(false, InRepLayout.BaseHandleToCmdIndex.Num())
+		, RepLayout(InRepLayout)
+	{}
+
+	void MarkChanged(uint16 Handle)
+	{
+		check(Handle > 0 && Handle - 1 < RepChanged.Num());
+		RepChanged[Handle - 1] = true;
+	}
+
+	// Marks the top-level handles of a changelist created by the replication system.
+	void MergeChangelist(const TArray<uint16>& Changelist)
+	{
+		FChangelistIterator ChangelistIterator(Changelist, 0);
+		FRepHandleIterator HandleIterator(ChangelistIterator, RepLayout.Cmds, RepLayout.BaseHandleToCmdIndex, 0, 1, 0, RepLayout.Cmds.Num() - 1);
+		while (HandleIterator.NextHandle())
+		{
+			MarkChanged(HandleIterator.Handle);
+
+			if (RepLayout.Cmds[HandleIterator.CmdIndex].Type == ERepLayoutCmdType::DynamicArray)
+			{
+				if (!HandleIterator.JumpOverArray())
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	bool HasChanges() const
+	{
+		return RepChanged.Find(true) != INDEX_NONE;
+	}
+
+	TBitArray<> RepChanged; // changed replicated properties
 	FRepLayout& RepLayout;
 };
 
@@ -167,21 +167,28 @@ inline TArray<UFunction*> GetClassRPCFunctions(const UClass* Class)
 		}
 	}
 
-	TArray<UFunction*> RelevantClassFunctions = AllClassFunctions;
+	// Collect the parent super functions which are overridden by another function in the list.
+	TSet<UFunction*> OverriddenFunctions;
+	OverriddenFunctions.Reserve(AllClassFunctions.Num());
 
-	// Remove parent super functions from the class RPC list so we only use the overridden functions in this class.
-	for (int i = 0; i < AllClassFunctions.Num(); i++)
+	for (UFunction* CurrentFunction : AllClassFunctions)
 	{
-		UFunction* CurrentFunction = AllClassFunctions[i];
+		if (UFunction* SuperFunction = CurrentFunction->GetSuperFunction())
+		{
+			OverriddenFunctions.Add(SuperFunction);
+		}
+	}
 
-		for (int j = 0; j < AllClassFunctions.Num(); j++)
+	// Remove parent super functions from the class RPC list so we only use the overridden functions in this class.
+	// The original order is preserved, as it determines the RPC indices used in the generated schema.
+	TArray<UFunction*> RelevantClassFunctions;
+	RelevantClassFunctions.Reserve(AllClassFunctions.Num());
+
+	for (UFunction* CurrentFunction : AllClassFunctions)
+	{
+		if (!OverriddenFunctions.Contains(CurrentFunction))
 		{
-			UFunction* PotentialParentFunction = AllClassFunctions[j];
-			if (CurrentFunction->GetSuperFunction() == PotentialParentFunction)
-			{
-				// Remove the parent function.
-				RelevantClassFunctions.Remove(PotentialParentFunction);
-			}
+			RelevantClassFunctions.Add(CurrentFunction);
 		}
 	}
 
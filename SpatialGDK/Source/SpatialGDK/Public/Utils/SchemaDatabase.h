@@ -40,12 +40,23 @@ class SPATIALGDK_API USchemaDatabase : public UDataAsset
 
 public:
 
-	USchemaDatabase() : NextAvailableComponentId(SpatialConstants::STARTING_GENERATED_COMPONENT_ID) {}
+	USchemaDatabase() : NextAvailableComponentId(SpatialConstants::STARTING_GENERATED_COMPONENT_ID), ComponentIdStride(0) {}
 
 	UPROPERTY(VisibleAnywhere)
 	TMap<FString, FSchemaData> ClassPathToSchema;
 
 	UPROPERTY(VisibleAnywhere)
 	uint32 NextAvailableComponentId;
+
+	// Generated component ids are handed out in slots of this many ids, one slot per actor or subobject, with the id for each
+	// ESchemaComponentType at a fixed position in its slot. Zero if the database predates this layout.
+	UPROPERTY(VisibleAnywhere)
+	uint32 ComponentIdStride;
+
+#if WITH_EDITORONLY_DATA
+	// Checksum of the type structure each class' schema was last generated from, used to skip regenerating unchanged classes.
+	UPROPERTY()
+	TMap<FString, uint32> ClassPathToChecksum;
+#endif
 };
 
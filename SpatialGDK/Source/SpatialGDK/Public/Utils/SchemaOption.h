@@ -1,50 +1,122 @@
 #pragma once
 
-#include "Templates/UniquePtr.h"
+#include "Templates/SharedPointer.h"
+#include "Templates/TypeCompatibleBytes.h"
 
 namespace improbable
 {
 
+// Optional schema field. The value is stored inline, so setting, copying or clearing an option never allocates on its own.
 template <typename T>
 class TSchemaOption
 {
 public:
-	TSchemaOption() = default;
-	~TSchemaOption() = default;
+	TSchemaOption()
+		: bIsSet(false)
+	{}
+
+	~TSchemaOption()
+	{
+		Reset();
+	}
 
 	TSchemaOption(const T& InValue)
-		: Value(MakeUnique<T>(InValue))
-	{}
+		: bIsSet(false)
+	{
+		Emplace(InValue);
+	}
 
 	TSchemaOption(T&& InValue)
-		: Value(MakeUnique<T>(MoveTemp(InValue)))
-	{}
+		: bIsSet(false)
+	{
+		Emplace(MoveTemp(InValue));
+	}
 
 	TSchemaOption(const TSchemaOption& InValue)
+		: bIsSet(false)
 	{
-		*this = InValue;
+		if (InValue.IsSet())
+		{
+			Emplace(InValue.GetValue());
+		}
 	}
 
-	TSchemaOption(TSchemaOption&&) = default;
+	TSchemaOption(TSchemaOption&& InValue)
+		: bIsSet(false)
+	{
+		if (InValue.IsSet())
+		{
+			Emplace(MoveTemp(InValue.GetValue()));
+			InValue.Reset();
+		}
+	}
 
 	TSchemaOption& operator=(const TSchemaOption& InValue)
 	{
 		if (this != &InValue)
 		{
-			if (InValue)
+			if (!InValue.IsSet())
+			{
+				Reset();
+			}
+			else if (IsSet())
+			{
+				// Assign rather than reconstruct, so a value that owns memory can reuse it.
+				GetValue() = InValue.GetValue();
+			}
+			else
+			{
+				Emplace(InValue.GetValue());
+			}
+		}
+
+		return *this;
+	}
+
+	TSchemaOption& operator=(TSchemaOption&& InValue)
+	{
+		if (this != &InValue)
+		{
+			if (!InValue.IsSet())
 			{
-				Value = MakeUnique<T>(*InValue);
+				Reset();
+			}
+			else if (IsSet())
+			{
+				GetValue() = MoveTemp(InValue.GetValue());
+				InValue.Reset();
+			}
+			else
+			{
+				Emplace(MoveTemp(InValue.GetValue()));
+				InValue.Reset();
 			}
 		}
 
 		return *this;
 	}
 
-	TSchemaOption& operator=(TSchemaOption&&) = default;
+	template <typename... ArgsType>
+	T& Emplace(ArgsType&&... Args)
+	{
+		Reset();
+		new (&Value) T(Forward<ArgsType>(Args)...);
+		bIsSet = true;
+		return GetValue();
+	}
+
+	void Reset()
+	{
+		if (bIsSet)
+		{
+			DestructItem(reinterpret_cast<T*>(&Value));
+			bIsSet = false;
+		}
+	}
 
 	FORCEINLINE bool IsSet() const
 	{
-		return Value.IsValid();
+		return bIsSet;
 	}
 
 	FORCEINLINE explicit operator bool() const
@@ -55,13 +127,13 @@ public:
 	const T& GetValue() const
 	{
 		checkf(IsSet(), TEXT("It is an error to call GetValue() on an unset TSchemaOption. Please check IsSet()."));
-		return *Value;
+		return *reinterpret_cast<const T*>(&Value);
 	}
 
 	T& GetValue()
 	{
 		checkf(IsSet(), TEXT("It is an error to call GetValue() on an unset TSchemaOption. Please check IsSet()."));
-		return *Value;
+		return *reinterpret_cast<T*>(&Value);
 	}
 
 	bool operator==(const TSchemaOption& InValue) const
@@ -84,23 +156,29 @@ public:
 		return !operator==(InValue);
 	}
 
-	T& operator*() const
+	const T& operator*() const
 	{
-		return *Value;
+		return GetValue();
+	}
+
+	T& operator*()
+	{
+		return GetValue();
 	}
 
 	const T* operator->() const
 	{
-		return Value.Get();
+		return &GetValue();
 	}
 
 	T* operator->()
 	{
-		return Value.Get();
+		return &GetValue();
 	}
 
 private:
-	TUniquePtr<T> Value;
+	TTypeCompatibleBytes<T> Value;
+	bool bIsSet;
 };
 
 template <typename T>
@@ -109,4 +187,101 @@ inline uint32 GetTypeHash(const improbable::TSchemaOption<T>& Option)
 	return Option.IsSet() ? 1327u * (GetTypeHash(*Option) + 977u) : 977u;
 }
 
+// Optional schema field for types which contain themselves (such as FUnrealObjectRef::Outer) and so can't be stored inline.
+// Copies share the value, which is only cloned when a shared copy is written to, so copying never allocates.
+template <typename T>
+class TSharedSchemaOption
+{
+public:
+	TSharedSchemaOption() = default;
+
+	TSharedSchemaOption(const T& InValue)
+		: Value(MakeShared<T>(InValue))
+	{}
+
+	TSharedSchemaOption(T&& InValue)
+		: Value(MakeShared<T>(MoveTemp(InValue)))
+	{}
+
+	void Reset()
+	{
+		Value.Reset();
+	}
+
+	FORCEINLINE bool IsSet() const
+	{
+		return Value.IsValid();
+	}
+
+	FORCEINLINE explicit operator bool() const
+	{
+		return IsSet();
+	}
+
+	const T& GetValue() const
+	{
+		checkf(IsSet(), TEXT("It is an error to call GetValue() on an unset TSharedSchemaOption. Please check IsSet()."));
+		return *Value;
+	}
+
+	T& GetValue()
+	{
+		checkf(IsSet(), TEXT("It is an error to call GetValue() on an unset TSharedSchemaOption. Please check IsSet()."));
+		if (!Value.IsUnique())
+		{
+			Value = MakeShared<T>(*Value);
+		}
+		return *Value;
+	}
+
+	bool operator==(const TSharedSchemaOption& InValue) const
+	{
+		if (IsSet() != InValue.IsSet())
+		{
+			return false;
+		}
+
+		if (!IsSet() || Value == InValue.Value)
+		{
+			return true;
+		}
+
+		return GetValue() == InValue.GetValue();
+	}
+
+	bool operator!=(const TSharedSchemaOption& InValue) const
+	{
+		return !operator==(InValue);
+	}
+
+	const T& operator*() const
+	{
+		return GetValue();
+	}
+
+	T& operator*()
+	{
+		return GetValue();
+	}
+
+	const T* operator->() const
+	{
+		return &GetValue();
+	}
+
+	T* operator->()
+	{
+		return &GetValue();
+	}
+
+private:
+	TSharedPtr<T> Value;
+};
+
+template <typename T>
+inline uint32 GetTypeHash(const improbable::TSharedSchemaOption<T>& Option)
+{
+	return Option.IsSet() ? 1327u * (GetTypeHash(*Option) + 977u) : 977u;
+}
+
 }
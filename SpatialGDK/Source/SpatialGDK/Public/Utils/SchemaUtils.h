@@ -57,6 +57,45 @@ inline TArray<uint8> GetBytesFromSchema(const Schema_Object* Object, Schema_Fiel
 	return IndexBytesFromSchema(Object, Id, 0);
 }
 
+// Adds Count elements as one list field. The elements are copied into a buffer owned by Object, converted to the type they
+// are stored as in schema (such as int8 to int32), so the caller's array doesn't have to outlive the object.
+template <typename SchemaType, typename ElementType>
+inline void AddListToSchema(Schema_Object* Object, Schema_FieldId Id, void (*AddList)(Schema_Object*, Schema_FieldId, const SchemaType*, uint32_t), const ElementType* Elements, uint32 Count)
+{
+	SchemaType* Buffer = reinterpret_cast<SchemaType*>(Schema_AllocateBuffer(Object, sizeof(SchemaType) * Count));
+	if (TAreTypesEqual<SchemaType, ElementType>::Value)
+	{
+		FMemory::Memcpy(Buffer, Elements, sizeof(SchemaType) * Count);
+	}
+	else
+	{
+		for (uint32 i = 0; i < Count; i++)
+		{
+			Buffer[i] = (SchemaType)Elements[i];
+		}
+	}
+	AddList(Object, Id, Buffer, Count);
+}
+
+// Reads a list field of Count values into Elements. Lists stored as the element type are read in place.
+template <typename SchemaType, typename ElementType>
+inline void GetListFromSchema(const Schema_Object* Object, Schema_FieldId Id, void (*GetList)(const Schema_Object*, Schema_FieldId, SchemaType*), ElementType* Elements, uint32 Count)
+{
+	if (TAreTypesEqual<SchemaType, ElementType>::Value)
+	{
+		GetList(Object, Id, reinterpret_cast<SchemaType*>(Elements));
+		return;
+	}
+
+	TArray<SchemaType> Values;
+	Values.SetNumUninitialized(Count);
+	GetList(Object, Id, Values.GetData());
+	for (uint32 i = 0; i < Count; i++)
+	{
+		Elements[i] = (ElementType)Values[i];
+	}
+}
+
 inline void AddWorkerRequirementSetToSchema(Schema_Object* Object, Schema_FieldId Id, const WorkerRequirementSet& Value)
 {
 	Schema_Object* RequirementSetObject = Schema_AddObject(Object, Id);
@@ -71,30 +110,48 @@ inline void AddWorkerRequirementSetToSchema(Schema_Object* Object, Schema_FieldI
 	}
 }
 
-inline WorkerRequirementSet GetWorkerRequirementSetFromSchema(Schema_Object* Object, Schema_FieldId Id)
+// Reads a string field into an existing string, reusing its memory. Leaves the string untouched if it already holds the value.
+inline void IndexStringFromSchema(const Schema_Object* Object, Schema_FieldId Id, uint32 Index, FString& OutString)
+{
+	FUTF8ToTCHAR Converted((const ANSICHAR*)Schema_IndexBytes(Object, Id, Index), (int32)Schema_IndexBytesLength(Object, Id, Index));
+	const int32 StringLength = Converted.Length();
+
+	if (OutString.Len() == StringLength && FCString::Strncmp(*OutString, Converted.Get(), StringLength) == 0)
+	{
+		return;
+	}
+
+	OutString.Reset(StringLength);
+	OutString.AppendChars(Converted.Get(), StringLength);
+}
+
+// Reads a requirement set into an existing one, reusing the memory of its attribute sets and strings.
+inline void GetWorkerRequirementSetFromSchema(Schema_Object* Object, Schema_FieldId Id, WorkerRequirementSet& OutRequirementSet)
 {
 	Schema_Object* RequirementSetObject = Schema_GetObject(Object, Id);
 
 	int32 AttributeSetCount = (int32)Schema_GetObjectCount(RequirementSetObject, 1);
-	WorkerRequirementSet RequirementSet;
-	RequirementSet.Reserve(AttributeSetCount);
+	OutRequirementSet.SetNum(AttributeSetCount, /* bAllowShrinking */ false);
 
 	for (int32 i = 0; i < AttributeSetCount; i++)
 	{
 		Schema_Object* AttributeSetObject = Schema_IndexObject(RequirementSetObject, 1, i);
 
 		int32 AttributeCount = (int32)Schema_GetBytesCount(AttributeSetObject, 1);
-		WorkerAttributeSet AttributeSet;
-		AttributeSet.Reserve(AttributeCount);
+		WorkerAttributeSet& AttributeSet = OutRequirementSet[i];
+		AttributeSet.SetNum(AttributeCount, /* bAllowShrinking */ false);
 
 		for (int32 j = 0; j < AttributeCount; j++)
 		{
-			AttributeSet.Add(IndexStringFromSchema(AttributeSetObject, 1, j));
+			IndexStringFromSchema(AttributeSetObject, 1, j, AttributeSet[j]);
 		}
-
-		RequirementSet.Add(AttributeSet);
 	}
+}
 
+inline WorkerRequirementSet GetWorkerRequirementSetFromSchema(Schema_Object* Object, Schema_FieldId Id)
+{
+	WorkerRequirementSet RequirementSet;
+	GetWorkerRequirementSetFromSchema(Object, Id, RequirementSet);
 	return RequirementSet;
 }
 
@@ -0,0 +1,49 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+
+#include "SpatialConstants.h"
+
+#include <WorkerSDK/improbable/c_worker.h>
+
+DECLARE_STATS_GROUP(TEXT("SpatialNet"), STATGROUP_SpatialNet, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_EXTERN(SpatialNet);
+
+// Times the enclosing scope with a cycle stat shown in `stat SpatialNet`, and with a timer of the same name in the SpatialNet
+// category of the CSV profiler, so a capture made with `csvprofile start` and `csvprofile stop` has the timings of every frame.
+#define SPATIALNET_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	CSV_SCOPED_TIMING_STAT(SpatialNet, Stat)
+
+// Times the enclosing scope with the per class stat of GetClassReplicationStatId, if the detailed stats are enabled.
+#if STATS
+#define SPATIALNET_SCOPE_CLASS_CYCLE_COUNTER(Class, bSent) \
+	FScopeCycleCounter SpatialNetClassCycleCounter(improbable::AreDetailedNetStatsEnabled() ? improbable::GetClassReplicationStatId(Class, bSent) : TStatId())
+#else
+#define SPATIALNET_SCOPE_CLASS_CYCLE_COUNTER(Class, bSent)
+#endif
+
+namespace improbable
+{
+
+// Whether the detailed SpatialNet stats are collected, toggled at runtime with `Spatial.DetailedNetStats 1`. These measure the
+// schema size of every component update and RPC sent or received, and time the replication of each actor class separately,
+// which costs too much to do all the time.
+SPATIALGDK_API bool AreDetailedNetStatsEnabled();
+
+// Add the schema size of a component update or RPC command request to the bytes sent or received for its component category.
+SPATIALGDK_API void RecordComponentUpdateBytes(ESchemaComponentType Type, bool bSent, const Worker_ComponentUpdate& Update);
+SPATIALGDK_API void RecordCommandRequestBytes(ESchemaComponentType Type, bool bSent, const Worker_CommandRequest& Request);
+
+#if STATS
+// A cycle stat named after the class, for timing the replication (sending) or application (receiving) of actors of that class.
+// Only meant to be used while AreDetailedNetStatsEnabled, since the stats are created on first use.
+SPATIALGDK_API TStatId GetClassReplicationStatId(UClass* Class, bool bSent);
+#endif
+
+}
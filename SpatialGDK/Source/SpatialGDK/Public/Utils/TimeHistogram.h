@@ -0,0 +1,35 @@
+// Copyright (c) Improbable Worlds Ltd, All Rights Reserved
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Counts time samples in fixed buckets from 1ms up to 250ms, plus one unbounded bucket for anything slower.
+// Samples are added in the histogram's own unit, given as the number of units per millisecond, so a histogram
+// of microseconds is constructed with 1000. Each sample is counted only in the first bucket that fits it.
+class SPATIALGDK_API FTimeHistogram
+{
+public:
+	static const int32 NumBuckets = 10;
+
+	explicit FTimeHistogram(double InUnitsPerMs = 1.0);
+
+	void AddSample(double Time);
+	void Reset();
+
+	// The upper bound of the bucket in the histogram's unit. The last bucket has no upper bound, so this returns the largest double.
+	double GetBucketUpperBound(int32 Bucket) const;
+
+	// The upper bound of the bucket containing the given fraction of the samples, or the largest sample if that is the last bucket.
+	double GetPercentileUpperBound(float Fraction) const;
+
+	double Sum;
+	double Max;
+	uint32 NumSamples;
+	uint32 BucketSamples[NumBuckets];
+
+private:
+	static const double BucketUpperBoundsMs[NumBuckets - 1];
+
+	double UnitsPerMs;
+};
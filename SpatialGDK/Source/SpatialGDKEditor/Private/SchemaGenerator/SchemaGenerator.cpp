@@ -208,6 +208,36 @@ bool IsReplicatedSubobject(TSharedPtr<FUnrealType> TypeInfo)
 	return false;
 }
 
+// Unreliable client and server RPCs can be sent as events on the RPC component the sending worker is authoritative over. So the
+// ClientRPC component, which the owning client is authoritative over, carries its unreliable server RPCs, and vice versa.
+bool HasUnreliableRPCEvent(ERPCType Group, const FUnrealRPCsByType& RPCsByType)
+{
+	const TArray<TSharedPtr<FUnrealRPC>>* EventRPCs = nullptr;
+	if (Group == RPC_Client)
+	{
+		EventRPCs = RPCsByType.Find(RPC_Server);
+	}
+	else if (Group == RPC_Server)
+	{
+		EventRPCs = RPCsByType.Find(RPC_Client);
+	}
+
+	if (EventRPCs == nullptr)
+	{
+		return false;
+	}
+
+	for (const TSharedPtr<FUnrealRPC>& RPC : *EventRPCs)
+	{
+		if (!RPC->bReliable)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void GenerateSubobjectSchema(UClass* Class, TSharedPtr<FUnrealType> TypeInfo, FString SchemaPath)
 {
 	FCodeWriter Writer;
@@ -298,12 +328,13 @@ void GenerateSubobjectSchema(UClass* Class, TSharedPtr<FUnrealType> TypeInfo, FS
 		Writer.Outdent().Print("}");
 	}
 
-	Writer.WriteToFile(FString::Printf(TEXT("%s%s.schema"), *SchemaPath, *ClassToSchemaName[Class]));
+	GeneratedSchemaFiles.Add(FString::Printf(TEXT("%s%s.schema"), *SchemaPath, *ClassToSchemaName[Class]), Writer.GetOutput());
 }
 
 int GenerateActorSchema(int ComponentId, UClass* Class, TSharedPtr<FUnrealType> TypeInfo, FString SchemaPath)
 {
 	const FSchemaData* const SchemaData = ClassPathToSchema.Find(*Class->GetPathName());
+	const uint32* const CachedComponentIds = SchemaData ? SchemaData->SchemaComponents : nullptr;
 
 	FCodeWriter Writer;
 
@@ -331,13 +362,11 @@ int GenerateActorSchema(int ComponentId, UClass* Class, TSharedPtr<FUnrealType>
 			continue;
 		}
 
-		const Worker_ComponentId CachedComponentId = SchemaData ? SchemaData->SchemaComponents[PropertyGroupToSchemaComponentType(Group)] : SpatialConstants::INVALID_COMPONENT_ID;
-
 		Writer.PrintNewLine();
 
 		Writer.Printf("component {0} {", *SchemaReplicatedDataName(Group, Class));
 		Writer.Indent();
-		Writer.Printf("id = {0};", IdGenerator.GetNextAvailableId(CachedComponentId));
+		Writer.Printf("id = {0};", IdGenerator.GetNextAvailableId(0, PropertyGroupToSchemaComponentType(Group), CachedComponentIds));
 
 		ActorSchemaData.SchemaComponents[PropertyGroupToSchemaComponentType(Group)] = IdGenerator.GetCurrentId();
 
@@ -349,6 +378,7 @@ int GenerateActorSchema(int ComponentId, UClass* Class, TSharedPtr<FUnrealType>
 				RepProp.Value,
 				RepProp.Value->ReplicationData->Handle);
 		}
+		Writer.Printf("event UnrealLatencyTrace latency_trace;");
 
 		Writer.Outdent().Print("}");
 	}
@@ -356,14 +386,12 @@ int GenerateActorSchema(int ComponentId, UClass* Class, TSharedPtr<FUnrealType>
 	FCmdHandlePropertyMap HandoverData = GetFlatHandoverData(TypeInfo);
 	if (HandoverData.Num() > 0)
 	{
-		const Worker_ComponentId CachedComponentId = SchemaData ? SchemaData->SchemaComponents[ESchemaComponentType::SCHEMA_Handover] : SpatialConstants::INVALID_COMPONENT_ID;
-
 		Writer.PrintNewLine();
 
 		// Handover (server to server) replicated properties.
 		Writer.Printf("component {0} {", *SchemaHandoverDataName(Class));
 		Writer.Indent();
-		Writer.Printf("id = {0};", IdGenerator.GetNextAvailableId(CachedComponentId));
+		Writer.Printf("id = {0};", IdGenerator.GetNextAvailableId(0, ESchemaComponentType::SCHEMA_Handover, CachedComponentIds));
 
 		ActorSchemaData.SchemaComponents[ESchemaComponentType::SCHEMA_Handover] = IdGenerator.GetCurrentId();
 
@@ -375,6 +403,7 @@ int GenerateActorSchema(int ComponentId, UClass* Class, TSharedPtr<FUnrealType>
 				Prop.Value,
 				FieldCounter);
 		}
+		Writer.Printf("event UnrealLatencyTrace latency_trace;");
 		Writer.Outdent().Print("}");
 	}
 
@@ -385,18 +414,17 @@ int GenerateActorSchema(int ComponentId, UClass* Class, TSharedPtr<FUnrealType>
 
 	for (auto Group : GetRPCTypes())
 	{
-		if (RPCsByType[Group].Num() == 0 && Group != RPC_Client)
+		const bool bHasUnreliableRPCEvent = HasUnreliableRPCEvent(Group, RPCsByType);
+		if (RPCsByType[Group].Num() == 0 && Group != RPC_Client && !bHasUnreliableRPCEvent)
 		{
 			continue;
 		}
 
-		const Worker_ComponentId CachedComponentId = SchemaData ? SchemaData->SchemaComponents[RPCTypeToSchemaComponentType(Group)] : SpatialConstants::INVALID_COMPONENT_ID;
-
 		Writer.PrintNewLine();
 
 		Writer.Printf("component {0} {", *SchemaRPCComponentName(Group, Class));
 		Writer.Indent();
-		Writer.Printf("id = {0};", IdGenerator.GetNextAvailableId(CachedComponentId));
+		Writer.Printf("id = {0};", IdGenerator.GetNextAvailableId(0, RPCTypeToSchemaComponentType(Group), CachedComponentIds));
 
 		ActorSchemaData.SchemaComponents[RPCTypeToSchemaComponentType(Group)] = IdGenerator.GetCurrentId();
 
@@ -418,6 +446,10 @@ int GenerateActorSchema(int ComponentId, UClass* Class, TSharedPtr<FUnrealType>
 					*SchemaRPCName(RPC->Function));
 			}
 		}
+		if (bHasUnreliableRPCEvent)
+		{
+			Writer.Printf("event UnrealUnreliableRPC unreliable_rpc;");
+		}
 		Writer.Outdent().Print("}");
 	}
 
@@ -436,7 +468,7 @@ int GenerateActorSchema(int ComponentId, UClass* Class, TSharedPtr<FUnrealType>
 
 	ClassPathToSchema.Add(Class->GetPathName(), ActorSchemaData);
 
-	Writer.WriteToFile(FString::Printf(TEXT("%s%s.schema"), *SchemaPath, *ClassToSchemaName[Class]));
+	GeneratedSchemaFiles.Add(FString::Printf(TEXT("%s%s.schema"), *SchemaPath, *ClassToSchemaName[Class]), Writer.GetOutput());
 
 	return IdGenerator.GetNumUsedIds();
 }
@@ -445,6 +477,7 @@ FSubobjectSchemaData GenerateSubobjectSpecificSchema(FCodeWriter& Writer, FCompo
 {
 	const FSchemaData* const SchemaData = ClassPathToSchema.Find(*ActorClass->GetPathName());
 	const FSubobjectSchemaData* const SubobjectSchemaData = SchemaData ? SchemaData->SubobjectData.Find(MapIndex) : nullptr;
+	const uint32* const CachedComponentIds = SubobjectSchemaData ? SubobjectSchemaData->SchemaComponents : nullptr;
 	
 	FUnrealFlatRepData RepData = GetFlatRepData(TypeInfo);
 
@@ -458,15 +491,14 @@ FSubobjectSchemaData GenerateSubobjectSpecificSchema(FCodeWriter& Writer, FCompo
 			continue;
 		}
 
-		const Worker_ComponentId CachedComponentId = SubobjectSchemaData ? SubobjectSchemaData->SchemaComponents[PropertyGroupToSchemaComponentType(Group)] : SpatialConstants::INVALID_COMPONENT_ID;
-
 		Writer.PrintNewLine();
 
 		FString ComponentName = PropertyName + GetReplicatedPropertyGroupName(Group);
 		Writer.Printf("component {0} {", *ComponentName);
 		Writer.Indent();
-		Writer.Printf("id = {0};", IdGenerator.GetNextAvailableId(CachedComponentId));
+		Writer.Printf("id = {0};", IdGenerator.GetNextAvailableId(MapIndex, PropertyGroupToSchemaComponentType(Group), CachedComponentIds));
 		Writer.Printf("data {0};", *SchemaReplicatedDataName(Group, ComponentClass));
+		Writer.Printf("event UnrealLatencyTrace latency_trace;");
 		Writer.Outdent().Print("}");
 
 		SubobjectData.SchemaComponents[PropertyGroupToSchemaComponentType(Group)] = IdGenerator.GetCurrentId();
@@ -475,15 +507,14 @@ FSubobjectSchemaData GenerateSubobjectSpecificSchema(FCodeWriter& Writer, FCompo
 	FCmdHandlePropertyMap HandoverData = GetFlatHandoverData(TypeInfo);
 	if (HandoverData.Num() > 0)
 	{
-		const Worker_ComponentId CachedComponentId = SubobjectSchemaData ? SubobjectSchemaData->SchemaComponents[ESchemaComponentType::SCHEMA_Handover] : SpatialConstants::INVALID_COMPONENT_ID;
-
 		Writer.PrintNewLine();
 
 		// Handover (server to server) replicated properties.
 		Writer.Printf("component {0} {", *(PropertyName + TEXT("Handover")));
 		Writer.Indent();
-		Writer.Printf("id = {0};", IdGenerator.GetNextAvailableId(CachedComponentId));
+		Writer.Printf("id = {0};", IdGenerator.GetNextAvailableId(MapIndex, ESchemaComponentType::SCHEMA_Handover, CachedComponentIds));
 		Writer.Printf("data {0};", *SchemaHandoverDataName(ComponentClass));
+		Writer.Printf("event UnrealLatencyTrace latency_trace;");
 		Writer.Outdent().Print("}");
 
 		SubobjectData.SchemaComponents[ESchemaComponentType::SCHEMA_Handover] = IdGenerator.GetCurrentId();
@@ -493,19 +524,18 @@ FSubobjectSchemaData GenerateSubobjectSpecificSchema(FCodeWriter& Writer, FCompo
 
 	for (auto Group : GetRPCTypes())
 	{
-		if (RPCsByType[Group].Num() == 0)
+		const bool bHasUnreliableRPCEvent = HasUnreliableRPCEvent(Group, RPCsByType);
+		if (RPCsByType[Group].Num() == 0 && !bHasUnreliableRPCEvent)
 		{
 			continue;
 		}
 
-		const Worker_ComponentId CachedComponentId = SubobjectSchemaData ? SubobjectSchemaData->SchemaComponents[RPCTypeToSchemaComponentType(Group)] : SpatialConstants::INVALID_COMPONENT_ID;
-
 		Writer.PrintNewLine();
 
 		FString ComponentName = PropertyName + GetRPCTypeName(Group) + TEXT("RPCs");
 		Writer.Printf("component {0} {", *ComponentName);
 		Writer.Indent();
-		Writer.Printf("id = {0};", IdGenerator.GetNextAvailableId(CachedComponentId));
+		Writer.Printf("id = {0};", IdGenerator.GetNextAvailableId(MapIndex, RPCTypeToSchemaComponentType(Group), CachedComponentIds));
 		for (auto& RPC : RPCsByType[Group])
 		{
 			if (Group == ERPCType::RPC_NetMulticast)
@@ -519,6 +549,10 @@ FSubobjectSchemaData GenerateSubobjectSpecificSchema(FCodeWriter& Writer, FCompo
 					*SchemaRPCName(RPC->Function));
 			}
 		}
+		if (bHasUnreliableRPCEvent)
+		{
+			Writer.Printf("event UnrealUnreliableRPC unreliable_rpc;");
+		}
 		Writer.Outdent().Print("}");
 
 		SubobjectData.SchemaComponents[RPCTypeToSchemaComponentType(Group)] = IdGenerator.GetCurrentId();
@@ -586,7 +620,7 @@ void GenerateSubobjectSchemaForActor(FComponentIdGenerator& IdGenerator, UClass*
 
 	if (bHasComponents)
 	{
-		Writer.WriteToFile(FString::Printf(TEXT("%s%sComponents.schema"), *SchemaPath, *ClassToSchemaName[ActorClass]));
+		GeneratedSchemaFiles.Add(FString::Printf(TEXT("%s%sComponents.schema"), *SchemaPath, *ClassToSchemaName[ActorClass]), Writer.GetOutput());
 	}
 }
 
@@ -609,8 +643,8 @@ void GenerateActorIncludes(FCodeWriter& Writer, TSharedPtr<FUnrealType>& TypeInf
 
 			if (Value != nullptr && !Value->IsEditorOnly() && IsReplicatedSubobject(PropertyTypeInfo))
 			{
-				// Only include core types if a subobject has any RPCs
-				bImportCoreTypes |= PropertyTypeInfo->RPCs.Num() > 0;
+				// Subobject data and handover components have a latency_trace event, and RPC components use the RPC types.
+				bImportCoreTypes = true;
 
 				UClass* Class = Value->GetClass();
 				if (!AlreadyImported.Contains(Class) && SchemaGeneratedClasses.Contains(Class))
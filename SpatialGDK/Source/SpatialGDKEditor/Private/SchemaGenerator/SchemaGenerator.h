@@ -13,6 +13,9 @@ struct FComponentIdGenerator;
 extern TArray<UClass*> SchemaGeneratedClasses;
 extern TMap<FString, FSchemaData> ClassPathToSchema;
 
+// Contents of the schema files generated in this run, keyed by file name. These are written to disk once generation has finished.
+extern TMap<FString, FString> GeneratedSchemaFiles;
+
 // Generates a schema file, given an output code writer, component ID, Unreal type and type info.
 int GenerateActorSchema(int ComponentId, UClass* Class, TSharedPtr<FUnrealType> TypeInfo, FString SchemaPath);
 void GenerateSubobjectSchema(UClass* Class, TSharedPtr<FUnrealType> TypeInfo, FString SchemaPath);
@@ -4,12 +4,15 @@
 
 #include "AssetRegistryModule.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "Components/SceneComponent.h"
 #include "Engine/LevelScriptActor.h"
 #include "GeneralProjectSettings.h"
 #include "GenericPlatform/GenericPlatformFile.h"
 #include "GenericPlatform/GenericPlatformProcess.h"
+#include "HAL/FileManager.h"
 #include "HAL/PlatformFilemanager.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "Misc/FileHelper.h"
 #include "Misc/MessageDialog.h"
 #include "Misc/MonitoredProcess.h"
@@ -30,8 +33,13 @@ DEFINE_LOG_CATEGORY(LogSpatialGDKSchemaGenerator);
 TArray<UClass*> SchemaGeneratedClasses;
 TArray<UClass*> AdditionalSchemaGeneratedClasses; //Used to keep UClasses in memory whilst generating schema for them.
 TMap<FString, FSchemaData> ClassPathToSchema;
+TMap<FString, uint32> ClassPathToChecksum;
+TMap<FString, FString> GeneratedSchemaFiles;
 uint32 NextAvailableComponentId;
 
+// Bump this whenever the format of the generated schema changes, so that incremental generation regenerates every class.
+const uint32 SchemaGeneratorVersion = 3;
+
 // Prevent name collisions
 TMap<UClass*, FString> ClassToSchemaName;
 TMap<FString, UClass*> UsedSchemaNames;
@@ -62,6 +70,71 @@ int GenerateCompleteSchemaFromClass(FString SchemaPath, int ComponentId, TShared
 	return NumComponents;
 }
 
+// Checksum of everything the schema generated for a class depends on: its type structure, its schema name and the schema names of its subobjects.
+uint32 GenerateSchemaChecksum(UClass* Class, TSharedPtr<FUnrealType> TypeInfo)
+{
+	uint32 Checksum = FCrc::MemCrc32(&SchemaGeneratorVersion, sizeof(SchemaGeneratorVersion));
+	Checksum = FCrc::StrCrc32(*ClassToSchemaName[Class], Checksum);
+
+	for (auto& PropertyPair : TypeInfo->Properties)
+	{
+		TSharedPtr<FUnrealType>& PropertyTypeInfo = PropertyPair.Value->Type;
+		if (PropertyTypeInfo.IsValid() && PropertyTypeInfo->Object != nullptr)
+		{
+			UClass* SubobjectClass = PropertyTypeInfo->Object->GetClass();
+			const uint8 bHasGeneratedSchema = SchemaGeneratedClasses.Contains(SubobjectClass);
+
+			Checksum = FCrc::StrCrc32(*ClassToSchemaName.FindRef(SubobjectClass), Checksum);
+			Checksum = FCrc::MemCrc32(&bHasGeneratedSchema, sizeof(bHasGeneratedSchema), Checksum);
+		}
+	}
+
+	return GenerateTypeChecksum(TypeInfo, Checksum);
+}
+
+// Returns true if the schema generated for this class during a previous run is still valid and present on disk.
+// The files making up that schema are added to OutUnchangedFiles.
+bool IsSchemaUpToDate(UClass* Class, uint32 Checksum, const TMap<FString, uint32>& PreviousChecksums, const FString& SchemaPath, TSet<FString>& OutUnchangedFiles)
+{
+	const FString ClassPath = Class->GetPathName();
+	const uint32* PreviousChecksum = PreviousChecksums.Find(ClassPath);
+	if (PreviousChecksum == nullptr || *PreviousChecksum != Checksum)
+	{
+		return false;
+	}
+
+	IFileManager& FileManager = IFileManager::Get();
+	const FString& SchemaName = ClassToSchemaName[Class];
+
+	if (!Class->IsChildOf<AActor>())
+	{
+		const FString SubobjectSchemaFile = FString::Printf(TEXT("%sSubobjects/%s.schema"), *SchemaPath, *SchemaName);
+		if (!FileManager.FileExists(*SubobjectSchemaFile))
+		{
+			return false;
+		}
+
+		OutUnchangedFiles.Add(FPaths::ConvertRelativePathToFull(SubobjectSchemaFile));
+		return true;
+	}
+
+	const FString ActorSchemaFile = FString::Printf(TEXT("%s%s.schema"), *SchemaPath, *SchemaName);
+	if (!ClassPathToSchema.Contains(ClassPath) || !FileManager.FileExists(*ActorSchemaFile))
+	{
+		return false;
+	}
+
+	OutUnchangedFiles.Add(FPaths::ConvertRelativePathToFull(ActorSchemaFile));
+
+	const FString ComponentsSchemaFile = FString::Printf(TEXT("%s%sComponents.schema"), *SchemaPath, *SchemaName);
+	if (FileManager.FileExists(*ComponentsSchemaFile))
+	{
+		OutUnchangedFiles.Add(FPaths::ConvertRelativePathToFull(ComponentsSchemaFile));
+	}
+
+	return true;
+}
+
 bool CheckIdentifierNameValidity(TSharedPtr<FUnrealType> TypeInfo)
 {
 	// Check Replicated Data
@@ -164,13 +237,88 @@ bool ValidateIdentifierNames(TArray<TSharedPtr<FUnrealType>>& TypeInfos)
 }// ::
 
 
-void  GenerateSchemaFromClasses(const TArray<TSharedPtr<FUnrealType>>& TypeInfos, const FString& CombinedSchemaPath)
+void GenerateSchemaFromClasses(const TArray<TSharedPtr<FUnrealType>>& TypeInfos, const FString& CombinedSchemaPath, TSet<FString>& OutUnchangedFiles)
 {
-	// Generate the actual schema
+	TMap<FString, uint32> PreviousChecksums = MoveTemp(ClassPathToChecksum);
+	ClassPathToChecksum.Empty(TypeInfos.Num());
+
+	int32 NumUnchangedClasses = 0;
+
+	// Generate the actual schema. This stays serial, as component ids are handed out in class order.
 	for (const auto& TypeInfo : TypeInfos)
 	{
+		UClass* Class = Cast<UClass>(TypeInfo->Type);
+		const uint32 Checksum = GenerateSchemaChecksum(Class, TypeInfo);
+		ClassPathToChecksum.Add(Class->GetPathName(), Checksum);
+
+		// Unchanged classes keep their component ids from the schema database, so skipping them doesn't affect the ids of other classes.
+		if (IsSchemaUpToDate(Class, Checksum, PreviousChecksums, CombinedSchemaPath, OutUnchangedFiles))
+		{
+			NumUnchangedClasses++;
+			continue;
+		}
+
 		NextAvailableComponentId += GenerateCompleteSchemaFromClass(CombinedSchemaPath, NextAvailableComponentId, TypeInfo);
 	}
+
+	UE_LOG(LogSpatialGDKSchemaGenerator, Display, TEXT("Generated schema for %d classes, %d classes were unchanged."), TypeInfos.Num() - NumUnchangedClasses, NumUnchangedClasses);
+}
+
+void WriteGeneratedSchemaFiles(const FString& SchemaOutputPath, const TSet<FString>& UnchangedFiles)
+{
+	TArray<FString> Filenames;
+	GeneratedSchemaFiles.GenerateKeyArray(Filenames);
+
+	FThreadSafeCounter NumFilesWritten;
+
+	ParallelFor(Filenames.Num(), [&Filenames, &NumFilesWritten](int32 Index)
+	{
+		const FString& Filename = Filenames[Index];
+		const FString& Contents = GeneratedSchemaFiles[Filename];
+
+		// Leave files with identical contents untouched, so tools watching the schema directory don't see spurious changes.
+		FString ExistingContents;
+		if (FFileHelper::LoadFileToString(ExistingContents, *Filename) && ExistingContents.Equals(Contents, ESearchCase::CaseSensitive))
+		{
+			return;
+		}
+
+		if (!FFileHelper::SaveStringToFile(Contents, *Filename))
+		{
+			UE_LOG(LogSpatialGDKSchemaGenerator, Error, TEXT("Could not write schema file '%s'! Please make sure the file is writeable."), *Filename);
+			return;
+		}
+
+		NumFilesWritten.Increment();
+	});
+
+	// Remove schema files which were neither generated nor left unchanged in this run, e.g. those of deleted or renamed classes.
+	TSet<FString> ExpectedFiles = UnchangedFiles;
+	for (const FString& Filename : Filenames)
+	{
+		ExpectedFiles.Add(FPaths::ConvertRelativePathToFull(Filename));
+	}
+
+	TArray<FString> ExistingFiles;
+	IFileManager::Get().FindFilesRecursive(ExistingFiles, *SchemaOutputPath, TEXT("*.schema"), true, false);
+
+	int32 NumFilesDeleted = 0;
+	for (const FString& ExistingFile : ExistingFiles)
+	{
+		if (!ExpectedFiles.Contains(FPaths::ConvertRelativePathToFull(ExistingFile)))
+		{
+			if (IFileManager::Get().Delete(*ExistingFile))
+			{
+				NumFilesDeleted++;
+			}
+			else
+			{
+				UE_LOG(LogSpatialGDKSchemaGenerator, Error, TEXT("Could not delete stale schema file '%s'! Please make sure the file is writeable."), *ExistingFile);
+			}
+		}
+	}
+
+	UE_LOG(LogSpatialGDKSchemaGenerator, Display, TEXT("Wrote %d of %d generated schema files, deleted %d stale schema files."), NumFilesWritten.GetValue(), Filenames.Num(), NumFilesDeleted);
 }
 
 
@@ -191,7 +339,9 @@ void SaveSchemaDatabase()
 
 		USchemaDatabase* SchemaDatabase = NewObject<USchemaDatabase>(Package, USchemaDatabase::StaticClass(), FName("SchemaDatabase"), EObjectFlags::RF_Public | EObjectFlags::RF_Standalone);
 		SchemaDatabase->NextAvailableComponentId = NextAvailableComponentId;
+		SchemaDatabase->ComponentIdStride = SCHEMA_Count;
 		SchemaDatabase->ClassPathToSchema = ClassPathToSchema;
+		SchemaDatabase->ClassPathToChecksum = ClassPathToChecksum;
 
 		FAssetRegistryModule::AssetCreated(SchemaDatabase);
 		SchemaDatabase->MarkPackageDirty();
@@ -277,6 +427,7 @@ void InitClassPathToSchemaMap()
 	if (SchemaDatabase)
 	{
 		ClassPathToSchema = SchemaDatabase->ClassPathToSchema;
+		ClassPathToChecksum = SchemaDatabase->ClassPathToChecksum;
 		NextAvailableComponentId = SchemaDatabase->NextAvailableComponentId;
 
 		// Component Id generation was updated to be non-destructive, if we detect an old schema database, delete it.
@@ -284,6 +435,16 @@ void InitClassPathToSchemaMap()
 		{
 			UE_LOG(LogSpatialGDKSchemaGenerator, Warning, TEXT("Detected an old schema database, it'll be reset."));
 			ClassPathToSchema.Empty();
+			ClassPathToChecksum.Empty();
+			DeleteGeneratedSchemaFiles();
+		}
+		// Component ids are now packed into a slot per actor and subobject. Ids from another layout can't be kept, so start over.
+		else if (ClassPathToSchema.Num() > 0 && SchemaDatabase->ComponentIdStride != SCHEMA_Count)
+		{
+			UE_LOG(LogSpatialGDKSchemaGenerator, Warning, TEXT("Detected a schema database with an old component id layout, it'll be reset. Snapshots will need to be regenerated."));
+			ClassPathToSchema.Empty();
+			ClassPathToChecksum.Empty();
+			NextAvailableComponentId = SpatialConstants::STARTING_GENERATED_COMPONENT_ID;
 			DeleteGeneratedSchemaFiles();
 		}
 	}
@@ -291,6 +452,7 @@ void InitClassPathToSchemaMap()
 	{
 		UE_LOG(LogSpatialGDKSchemaGenerator, Log, TEXT("SchemaDatabase not found on Engine startup so the generated schema directory will be cleared out if it exists."));
 		NextAvailableComponentId = SpatialConstants::STARTING_GENERATED_COMPONENT_ID;
+		ClassPathToChecksum.Empty();
 		// As a safety precaution, if the SchemaDatabase.uasset doesn't exist then make sure the schema generated folder is cleared as well. 
 		DeleteGeneratedSchemaFiles();
 	}
@@ -338,15 +500,21 @@ bool SpatialGDKGenerateSchema()
 	SchemaGeneratedClasses = GetAllSupportedClasses();
 	SchemaGeneratedClasses.Sort();
 
-	// Generate Type Info structs for all classes
+	double TypeInfoStartTime = FPlatformTime::Seconds();
+
+	// Generate Type Info structs for all classes. This stays on the game thread, as building the type info creates the default
+	// objects of the classes it recurses into, which isn't safe to do concurrently.
 	TArray<TSharedPtr<FUnrealType>> TypeInfos;
+	TypeInfos.Reserve(SchemaGeneratedClasses.Num());
 
-	for (const auto& Class : SchemaGeneratedClasses)
+	for (UClass* Class : SchemaGeneratedClasses)
 	{
 		// Parent and static array index start at 0 for checksum calculations.
 		TypeInfos.Add(CreateUnrealTypeInfo(Class, 0, 0, false));
 	}
 
+	UE_LOG(LogSpatialGDKSchemaGenerator, Display, TEXT("Built type info for %d classes in %.2f ms."), TypeInfos.Num(), (FPlatformTime::Seconds() - TypeInfoStartTime) * 1000.0);
+
 	if (!ValidateIdentifierNames(TypeInfos))
 	{
 		return false;
@@ -365,9 +533,12 @@ bool SpatialGDKGenerateSchema()
 
 	check(GetDefault<UGeneralProjectSettings>()->bSpatialNetworking);
 
-	DeleteGeneratedSchemaFiles();
+	GeneratedSchemaFiles.Empty();
+	TSet<FString> UnchangedSchemaFiles;
 
-	GenerateSchemaFromClasses(TypeInfos, SchemaOutputPath);
+	GenerateSchemaFromClasses(TypeInfos, SchemaOutputPath, UnchangedSchemaFiles);
+	WriteGeneratedSchemaFiles(SchemaOutputPath, UnchangedSchemaFiles);
+	GeneratedSchemaFiles.Empty();
 
 	SaveSchemaDatabase();
 
@@ -166,6 +166,75 @@ uint32 GenerateChecksum(UProperty* Property, uint32 ParentChecksum, int32 Static
 	return Checksum;
 }
 
+uint32 GenerateTypeChecksum(TSharedPtr<FUnrealType> TypeInfo, uint32 Checksum)
+{
+	// Evolves the checksum with the parts of a property which end up in the generated schema.
+	auto PropertyChecksum = [](UProperty* Property, uint32 InChecksum)
+	{
+		InChecksum = FCrc::StrCrc32(*Property->GetName(), InChecksum);
+		InChecksum = FCrc::StrCrc32(*Property->GetClass()->GetName(), InChecksum);
+		InChecksum = FCrc::StrCrc32(*Property->GetCPPType(nullptr, 0), InChecksum);
+		InChecksum = FCrc::MemCrc32(&Property->ArrayDim, sizeof(Property->ArrayDim), InChecksum);
+		InChecksum = FCrc::MemCrc32(&Property->ElementSize, sizeof(Property->ElementSize), InChecksum);
+		return InChecksum;
+	};
+
+	Checksum = FCrc::StrCrc32(*TypeInfo->Type->GetPathName(), Checksum);
+	Checksum = FCrc::StrCrc32(*TypeInfo->Name.ToString(), Checksum);
+
+	if (TypeInfo->Object != nullptr)
+	{
+		Checksum = FCrc::StrCrc32(*TypeInfo->Object->GetClass()->GetPathName(), Checksum);
+	}
+
+	for (auto& PropertyPair : TypeInfo->Properties)
+	{
+		TSharedPtr<FUnrealProperty> PropertyNode = PropertyPair.Value;
+
+		Checksum = PropertyChecksum(PropertyNode->Property, Checksum);
+		Checksum = FCrc::MemCrc32(&PropertyNode->CompatibleChecksum, sizeof(PropertyNode->CompatibleChecksum), Checksum);
+		Checksum = FCrc::MemCrc32(&PropertyNode->StaticArrayIndex, sizeof(PropertyNode->StaticArrayIndex), Checksum);
+
+		if (PropertyNode->ReplicationData.IsValid())
+		{
+			const FUnrealRepData& RepData = *PropertyNode->ReplicationData;
+			const int32 RepValues[] = { RepData.RepLayoutType, RepData.Condition, RepData.RepNotifyCondition, RepData.Handle, RepData.RoleSwapHandle, RepData.ArrayIndex };
+			Checksum = FCrc::MemCrc32(RepValues, sizeof(RepValues), Checksum);
+		}
+
+		if (PropertyNode->HandoverData.IsValid())
+		{
+			Checksum = FCrc::MemCrc32(&PropertyNode->HandoverData->Handle, sizeof(PropertyNode->HandoverData->Handle), Checksum);
+		}
+
+		if (PropertyNode->Type.IsValid())
+		{
+			Checksum = GenerateTypeChecksum(PropertyNode->Type, Checksum);
+		}
+	}
+
+	for (auto& RPCPair : TypeInfo->RPCs)
+	{
+		TSharedPtr<FUnrealRPC> RPCNode = RPCPair.Value;
+
+		const int32 RPCValues[] = { RPCNode->Type, RPCNode->bReliable };
+		Checksum = FCrc::StrCrc32(*RPCNode->Function->GetName(), Checksum);
+		Checksum = FCrc::MemCrc32(RPCValues, sizeof(RPCValues), Checksum);
+
+		for (auto& ParameterPair : RPCNode->Parameters)
+		{
+			Checksum = PropertyChecksum(ParameterPair.Value->Property, Checksum);
+
+			if (ParameterPair.Value->Type.IsValid())
+			{
+				Checksum = GenerateTypeChecksum(ParameterPair.Value->Type, Checksum);
+			}
+		}
+	}
+
+	return Checksum;
+}
+
 TSharedPtr<FUnrealProperty> CreateUnrealProperty(TSharedPtr<FUnrealType> TypeNode, UProperty* Property, uint32 ParentChecksum, uint32 StaticArrayIndex)
 {
 	TSharedPtr<FUnrealProperty> PropertyNode = MakeShared<FUnrealProperty>();
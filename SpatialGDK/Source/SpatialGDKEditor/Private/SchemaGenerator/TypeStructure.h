@@ -195,6 +195,10 @@ void VisitAllProperties(TSharedPtr<FUnrealRPC> RPCNode, TFunction<bool(TSharedPt
 // Generates a unique checksum for the Property that allows matching to Unreal's RepLayout Cmds.
 uint32 GenerateChecksum(UProperty* Property, uint32 ParentChecksum, int32 StaticArrayIndex);
 
+// Generates a checksum over the structure of an AST (properties, replication and handover data, RPCs and subobjects),
+// which changes whenever the schema generated from that AST would change. Used to skip regenerating schema for unchanged types.
+uint32 GenerateTypeChecksum(TSharedPtr<FUnrealType> TypeInfo, uint32 Checksum);
+
 // Creates a new FUnrealProperty for the included UProperty, generates a checksum for it and then adds it to the TypeNode included.
 TSharedPtr<FUnrealProperty> CreateUnrealProperty(TSharedPtr<FUnrealType> TypeNode, UProperty* Property, uint32 ParentChecksum, uint32 StaticArrayIndex);
 
@@ -117,6 +117,12 @@ void FCodeWriter::WriteToFile(const FString& Filename)
 	FFileHelper::SaveStringToFile(OutputSource, *Filename);
 }
 
+const FString& FCodeWriter::GetOutput() const
+{
+	check(Scope == 0);
+	return OutputSource;
+}
+
 void FCodeWriter::Dump()
 {
 	UE_LOG(LogTemp, Warning, TEXT("%s"), *OutputSource);
@@ -47,6 +47,7 @@ public:
 	FCodeWriter& End();
 
 	void WriteToFile(const FString& Filename);
+	const FString& GetOutput() const;
 	void Dump();
 
 	FCodeWriter(const FCodeWriter& other) = delete;
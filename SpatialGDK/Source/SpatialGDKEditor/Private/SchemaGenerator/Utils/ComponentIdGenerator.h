@@ -2,30 +2,80 @@
 
 #pragma once
 
+// Hands out the component ids of one actor class. Ids are allocated in slots of SCHEMA_Count ids, one slot per object (the actor
+// at offset 0 and each of its subobjects), with the id for each ESchemaComponentType at a fixed position in the slot. The new
+// slots of a class are contiguous. This lets USpatialClassInfoManager find the class, offset and type of a component id with
+// arithmetic instead of hash lookups.
 struct FComponentIdGenerator
 {
-	FComponentIdGenerator(int StartId) : InitialId(StartId), IdReturned(StartId), NumIds(0)
+	FComponentIdGenerator(uint32 StartId) : InitialId(StartId), FirstSlotId(AlignToSlot(StartId)), NumSlots(0), IdReturned(SpatialConstants::INVALID_COMPONENT_ID)
 	{
 	}
 
-	int GetNextAvailableId(const uint32 InComponentId)
+	// CachedComponentIds are the ids the object at Offset had in the previous generation (or nullptr), and are kept so ids stay
+	// stable. New types of an object that already has a slot go into that slot, which is reserved in full.
+	uint32 GetNextAvailableId(int32 Offset, ESchemaComponentType Type, const uint32* CachedComponentIds)
 	{
-		IdReturned = InComponentId != SpatialConstants::INVALID_COMPONENT_ID ? InComponentId : InitialId + (NumIds++);
+		if (CachedComponentIds != nullptr && CachedComponentIds[Type] != SpatialConstants::INVALID_COMPONENT_ID)
+		{
+			IdReturned = CachedComponentIds[Type];
+			return IdReturned;
+		}
+
+		IdReturned = GetSlotId(Offset, CachedComponentIds) + Type;
 		return IdReturned;
 	}
 
-	int GetCurrentId() const
+	uint32 GetCurrentId() const
 	{
 		return IdReturned;
 	}
 
-	int GetNumUsedIds() const
+	// Number of ids consumed from StartId, including the padding needed to align the first slot.
+	uint32 GetNumUsedIds() const
 	{
-		return NumIds;
+		return NumSlots > 0 ? FirstSlotId + NumSlots * SCHEMA_Count - InitialId : 0;
 	}
 
 private:
-	int InitialId;
-	int NumIds;
-	int IdReturned;
+	static uint32 AlignToSlot(uint32 Id)
+	{
+		const uint32 Remainder = (Id - SpatialConstants::STARTING_GENERATED_COMPONENT_ID) % SCHEMA_Count;
+		return Remainder == 0 ? Id : Id + SCHEMA_Count - Remainder;
+	}
+
+	uint32 GetSlotId(int32 Offset, const uint32* CachedComponentIds)
+	{
+		if (uint32* SlotId = OffsetToSlotId.Find(Offset))
+		{
+			return *SlotId;
+		}
+
+		uint32 SlotId = SpatialConstants::INVALID_COMPONENT_ID;
+		if (CachedComponentIds != nullptr)
+		{
+			for (int32 CachedType = SCHEMA_Begin; CachedType < SCHEMA_Count; CachedType++)
+			{
+				if (CachedComponentIds[CachedType] != SpatialConstants::INVALID_COMPONENT_ID)
+				{
+					SlotId = CachedComponentIds[CachedType] - CachedType;
+					break;
+				}
+			}
+		}
+
+		if (SlotId == SpatialConstants::INVALID_COMPONENT_ID)
+		{
+			SlotId = FirstSlotId + (NumSlots++) * SCHEMA_Count;
+		}
+
+		OffsetToSlotId.Add(Offset, SlotId);
+		return SlotId;
+	}
+
+	uint32 InitialId;
+	uint32 FirstSlotId;
+	uint32 NumSlots;
+	uint32 IdReturned;
+	TMap<int32, uint32> OffsetToSlotId;
 };
@@ -19,9 +19,14 @@
 #include "Utils/RepLayoutUtils.h"
 #include "Utils/SchemaUtils.h"
 
+#include "Async/Async.h"
+#include "Containers/Queue.h"
 #include "EngineUtils.h"
+#include "HAL/Event.h"
 #include "HAL/PlatformFile.h"
 #include "HAL/PlatformFilemanager.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "UObject/UObjectIterator.h"
 
 #include <WorkerSDK/improbable/c_worker.h>
@@ -271,11 +276,8 @@ TArray<Worker_ComponentData> CreateStartupActorData(USpatialActorChannel* Channe
 	return ComponentData;
 }
 
-bool CreateStartupActor(Worker_SnapshotOutputStream* OutputStream, AActor* Actor, Worker_EntityId EntityId, USpatialNetConnection* NetConnection, USpatialClassInfoManager* ClassInfoManager)
+TArray<Worker_ComponentData> CreateStartupActorComponents(AActor* Actor, Worker_EntityId EntityId, USpatialNetConnection* NetConnection, USpatialClassInfoManager* ClassInfoManager)
 {
-	Worker_Entity Entity;
-	Entity.entity_id = EntityId;
-
 	UClass* ActorClass = Actor->GetClass();
 
 	const FClassInfo& ActorInfo = ClassInfoManager->GetOrCreateClassInfoByClass(ActorClass);
@@ -351,12 +353,143 @@ bool CreateStartupActor(Worker_SnapshotOutputStream* OutputStream, AActor* Actor
 
 	Components.Append(CreateStartupActorData(Channel, Actor, ClassInfoManager, Cast<USpatialNetDriver>(NetConnection->Driver)));
 
+	return Components;
+}
+
+bool CreateStartupActor(Worker_SnapshotOutputStream* OutputStream, AActor* Actor, Worker_EntityId EntityId, USpatialNetConnection* NetConnection, USpatialClassInfoManager* ClassInfoManager)
+{
+	TArray<Worker_ComponentData> Components = CreateStartupActorComponents(Actor, EntityId, NetConnection, ClassInfoManager);
+
+	Worker_Entity Entity;
+	Entity.entity_id = EntityId;
 	Entity.component_count = Components.Num();
 	Entity.components = Components.GetData();
 
 	return Worker_SnapshotOutputStream_WriteEntity(OutputStream, &Entity) != 0;
 }
 
+// Writes entities to a snapshot output stream from a dedicated thread. Building the component data of startup actors touches
+// UObjects, the package map and actor channels, so it has to stay on the game thread; this lets it overlap with the schema
+// serialization and file IO done by Worker_SnapshotOutputStream_WriteEntity instead of waiting on every entity in turn.
+class FSnapshotEntityWriter
+{
+public:
+	explicit FSnapshotEntityWriter(Worker_SnapshotOutputStream* InOutputStream)
+		: OutputStream(InOutputStream)
+		, WorkAvailableEvent(FPlatformProcess::GetSynchEventFromPool())
+		, WriteTimeSeconds(0.0)
+	{
+		WriterThread = Async<bool>(EAsyncExecution::Thread, [this]() { return Run(); });
+	}
+
+	~FSnapshotEntityWriter()
+	{
+		Finish();
+		FPlatformProcess::ReturnSynchEventToPool(WorkAvailableEvent);
+	}
+
+	// Queues an entity for writing. Blocks while too many entities are waiting, so the game thread cannot run arbitrarily far ahead.
+	void Enqueue(Worker_EntityId EntityId, TArray<Worker_ComponentData>&& Components)
+	{
+		while (NumPendingEntities.GetValue() >= MaxPendingEntities && !bWriteFailed)
+		{
+			FPlatformProcess::Sleep(0.0f);
+		}
+
+		PendingEntities.Enqueue(FPendingEntity{ EntityId, MoveTemp(Components) });
+		NumPendingEntities.Increment();
+		WorkAvailableEvent->Trigger();
+	}
+
+	// Waits until every queued entity has been written. Returns false if any write failed, in which case
+	// Worker_SnapshotOutputStream_GetError describes the failure.
+	bool Finish()
+	{
+		if (WriterThread.IsValid())
+		{
+			bNoMoreEntities = true;
+			WorkAvailableEvent->Trigger();
+			WriterThread.Wait();
+		}
+
+		return !bWriteFailed;
+	}
+
+	bool HasFailed() const
+	{
+		return bWriteFailed;
+	}
+
+	// Time the writer thread spent inside Worker_SnapshotOutputStream_WriteEntity. Only valid after Finish.
+	double GetWriteTimeSeconds() const
+	{
+		return WriteTimeSeconds;
+	}
+
+private:
+	struct FPendingEntity
+	{
+		Worker_EntityId EntityId;
+		TArray<Worker_ComponentData> Components;
+	};
+
+	bool Run()
+	{
+		FPendingEntity PendingEntity;
+		while (true)
+		{
+			if (!PendingEntities.Dequeue(PendingEntity))
+			{
+				if (bNoMoreEntities)
+				{
+					// Entities may have been queued between the failed dequeue and reading the flag.
+					if (PendingEntities.IsEmpty())
+					{
+						break;
+					}
+					continue;
+				}
+
+				WorkAvailableEvent->Wait();
+				continue;
+			}
+
+			NumPendingEntities.Decrement();
+
+			if (bWriteFailed)
+			{
+				// Keep draining so the game thread is never left blocked in Enqueue.
+				continue;
+			}
+
+			Worker_Entity Entity;
+			Entity.entity_id = PendingEntity.EntityId;
+			Entity.component_count = PendingEntity.Components.Num();
+			Entity.components = PendingEntity.Components.GetData();
+
+			const double StartTime = FPlatformTime::Seconds();
+			if (Worker_SnapshotOutputStream_WriteEntity(OutputStream, &Entity) == 0)
+			{
+				bWriteFailed = true;
+			}
+			WriteTimeSeconds += FPlatformTime::Seconds() - StartTime;
+		}
+
+		return !bWriteFailed;
+	}
+
+	static const int32 MaxPendingEntities = 256;
+
+	Worker_SnapshotOutputStream* OutputStream;
+	TQueue<FPendingEntity, EQueueMode::Spsc> PendingEntities;
+	FThreadSafeCounter NumPendingEntities;
+	FEvent* WorkAvailableEvent;
+	FThreadSafeBool bNoMoreEntities;
+	FThreadSafeBool bWriteFailed;
+	TFuture<bool> WriterThread;
+	double WriteTimeSeconds;
+};
+
 bool ProcessSupportedActors(const TSet<AActor*>& Actors, USpatialClassInfoManager* ClassInfoManager, TFunction<bool(AActor*, Worker_EntityId)> Process)
 {
 	Worker_EntityId CurrentEntityId = SpatialConstants::PLACEHOLDER_ENTITY_ID_LAST + 1;
@@ -405,19 +538,48 @@ bool CreateStartupActors(Worker_SnapshotOutputStream* OutputStream, UWorld* Worl
 	}
 
 	bool bSuccess = true;
+	int32 NumStartupActors = 0;
+
+	double StartTime = FPlatformTime::Seconds();
 
 	// Need to add all actors in the world to the package map so they have assigned UnrealObjRefs for the ComponentFactory to use
-	bSuccess &= ProcessSupportedActors(WorldActors, ClassInfoManager, [&PackageMap, &EntityRegistry, &ClassInfoManager](AActor* Actor, Worker_EntityId EntityId)
+	bSuccess &= ProcessSupportedActors(WorldActors, ClassInfoManager, [&PackageMap, &EntityRegistry, &ClassInfoManager, &NumStartupActors](AActor* Actor, Worker_EntityId EntityId)
 	{
 		EntityRegistry->AddToRegistry(EntityId, Actor);
 		PackageMap->ResolveEntityActor(Actor, EntityId);
+		NumStartupActors++;
 		return true;
 	});
 
-	bSuccess &= ProcessSupportedActors(WorldActors, ClassInfoManager, [&NetConnection, &OutputStream, &ClassInfoManager](AActor* Actor, Worker_EntityId EntityId)
+	UE_LOG(LogSpatialGDKSnapshot, Display, TEXT("Registered %d startup actors in %.3f seconds"), NumStartupActors, FPlatformTime::Seconds() - StartTime);
+	StartTime = FPlatformTime::Seconds();
+
+	if (GetDefault<USpatialGDKEditorSettings>()->bWriteSnapshotOnBackgroundThread)
 	{
-		return CreateStartupActor(OutputStream, Actor, EntityId, NetConnection, ClassInfoManager);
-	});
+		FSnapshotEntityWriter Writer(OutputStream);
+
+		bSuccess &= ProcessSupportedActors(WorldActors, ClassInfoManager, [&NetConnection, &Writer, &ClassInfoManager](AActor* Actor, Worker_EntityId EntityId)
+		{
+			Writer.Enqueue(EntityId, CreateStartupActorComponents(Actor, EntityId, NetConnection, ClassInfoManager));
+			return !Writer.HasFailed();
+		});
+
+		const double BuildTime = FPlatformTime::Seconds() - StartTime;
+
+		bSuccess &= Writer.Finish();
+
+		UE_LOG(LogSpatialGDKSnapshot, Display, TEXT("Built startup actor data in %.3f seconds, writer thread spent %.3f seconds writing, finished after %.3f seconds"),
+			BuildTime, Writer.GetWriteTimeSeconds(), FPlatformTime::Seconds() - StartTime);
+	}
+	else
+	{
+		bSuccess &= ProcessSupportedActors(WorldActors, ClassInfoManager, [&NetConnection, &OutputStream, &ClassInfoManager](AActor* Actor, Worker_EntityId EntityId)
+		{
+			return CreateStartupActor(OutputStream, Actor, EntityId, NetConnection, ClassInfoManager);
+		});
+
+		UE_LOG(LogSpatialGDKSnapshot, Display, TEXT("Built and wrote startup actors in %.3f seconds"), FPlatformTime::Seconds() - StartTime);
+	}
 
 	CleanupNetDriverAndConnection(NetDriver, NetConnection);
 
@@ -447,6 +609,8 @@ bool ValidateAndCreateSnapshotGenerationPath(FString& SavePath)
 
 bool FillSnapshot(Worker_SnapshotOutputStream* OutputStream, UWorld* World)
 {
+	const double StartTime = FPlatformTime::Seconds();
+
 	if (!CreateSpawnerEntity(OutputStream))
 	{
 		UE_LOG(LogSpatialGDKSnapshot, Error, TEXT("Error generating Spawner in snapshot: %s"), UTF8_TO_TCHAR(Worker_SnapshotOutputStream_GetError(OutputStream)));
@@ -465,12 +629,18 @@ bool FillSnapshot(Worker_SnapshotOutputStream* OutputStream, UWorld* World)
 		return false;
 	}
 
+	const double StartupActorsStartTime = FPlatformTime::Seconds();
+	UE_LOG(LogSpatialGDKSnapshot, Display, TEXT("Wrote Spawner, GlobalStateManager and Placeholders in %.3f seconds"), StartupActorsStartTime - StartTime);
+
 	if (!CreateStartupActors(OutputStream, World))
 	{
 		UE_LOG(LogSpatialGDKSnapshot, Error, TEXT("Error generating Startup Actors in snapshot: %s"), UTF8_TO_TCHAR(Worker_SnapshotOutputStream_GetError(OutputStream)));
 		return false;
 	}
 
+	UE_LOG(LogSpatialGDKSnapshot, Display, TEXT("Generated snapshot in %.3f seconds (startup actors took %.3f seconds)"),
+		FPlatformTime::Seconds() - StartTime, FPlatformTime::Seconds() - StartupActorsStartTime);
+
 	return true;
 }
 
@@ -19,6 +19,7 @@ FString USpatialGDKEditorSettings::ToString()
 	Args.Add(bStopSpatialOnExit);
 	Args.Add(SpatialOSSnapshotPath.Path);
 	Args.Add(SpatialOSSnapshotFile);
+	Args.Add(bWriteSnapshotOnBackgroundThread);
 	Args.Add(GeneratedSchemaOutputFolder.Path);
 
 	return FString::Format(TEXT(
@@ -27,7 +28,8 @@ FString USpatialGDKEditorSettings::ToString()
 		"bStopSpatialOnExit={2}, "
 		"SpatialOSSnapshotPath={3}, "
 		"SpatialOSSnapshotFile={4}, "
-		"GeneratedSchemaOutputFolder={5}")
+		"bWriteSnapshotOnBackgroundThread={5}, "
+		"GeneratedSchemaOutputFolder={6}")
 		, Args);
 }
 
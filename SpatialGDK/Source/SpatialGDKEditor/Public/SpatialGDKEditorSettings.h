@@ -38,6 +38,12 @@ private:
 	UPROPERTY(EditAnywhere, config, Category = "Snapshots", meta = (ConfigRestartRequired = false, DisplayName = "Snapshot file name"))
 	FString SpatialOSSnapshotFile;
 
+public:
+	/** Write snapshot entities on a dedicated thread while the next startup actors are being serialized. */
+	UPROPERTY(EditAnywhere, config, Category = "Snapshots", meta = (ConfigRestartRequired = false, DisplayName = "Write snapshot on background thread"))
+	bool bWriteSnapshotOnBackgroundThread;
+
+private:
 	/** Generated schema output path */
 	UPROPERTY(EditAnywhere, config, Category = "Schema", meta = (ConfigRestartRequired = false, DisplayName = "Output path for the generated schemas"))
 	FDirectoryPath GeneratedSchemaOutputFolder;